@@ -31,6 +31,8 @@ int main(int argc, char* argv[]) {
         bool autotest_mode = false;
         std::string autotest_output = "autotest_report.txt";
         bool test_mode = false;
+        int max_fps = 60;
+        std::string perf_counters_file;
         
         // Add positional argument for log file or directory
         app.add_option("path", input_path, 
@@ -90,6 +92,15 @@ int main(int argc, char* argv[]) {
         app.add_flag("--test", test_mode,
                      "Run in test mode - loads file and exits after 5 seconds");
         
+        // Add redraw rate option
+        app.add_option("--max-fps", max_fps,
+                       "Maximum redraws per second caused by tailing and background search (default: 60)")
+           ->check(CLI::PositiveNumber);
+        
+        // Add performance counters output option
+        app.add_option("--perf-counters", perf_counters_file,
+                       "Write frame, input, filter, search and ingest timings (p50/p99) to this file on exit");
+        
         // Parse command line arguments
         try {
             app.parse(argc, argv);
@@ -172,6 +183,8 @@ int main(int argc, char* argv[]) {
             
             // Initialize the main window
             main_window->Initialize();
+            main_window->SetMaxRedrawFps(max_fps);
+            main_window->SetPerfCountersFile(perf_counters_file);
             
             // Load the log file if provided
             if (!input_path.empty()) {
@@ -216,6 +229,11 @@ int main(int argc, char* argv[]) {
             std::cout << "Starting UI loop in test mode..." << std::endl;
             screen.Loop(component);
             
+            auto perf_result = main_window->WritePerfCounters();
+            if (perf_result.IsError()) {
+                std::cerr << "Warning: " << perf_result.Get_error_message() << std::endl;
+            }
+            
             std::cout << "Test mode completed." << std::endl;
             return 0;
         }
@@ -229,6 +247,8 @@ int main(int argc, char* argv[]) {
         
         // Initialize the main window
         main_window->Initialize();
+        main_window->SetMaxRedrawFps(max_fps);
+        main_window->SetPerfCountersFile(perf_counters_file);
         
         // Determine what to do based on input_path
         std::string resolved_path = input_path;
@@ -323,6 +343,11 @@ int main(int argc, char* argv[]) {
         std::cout << "Starting UI loop... (Press 'q' to quit, 'h' for help)" << std::endl;
         screen.Loop(component);
         
+        auto perf_result = main_window->WritePerfCounters();
+        if (perf_result.IsError()) {
+            std::cerr << "Warning: " << perf_result.Get_error_message() << std::endl;
+        }
+        
         std::cout << "Unreal Log Viewer exiting..." << std::endl;
         return 0;
         
@@ -0,0 +1,755 @@
+#include "linear_regex.h"
+#include <algorithm>
+#include <limits>
+#include <map>
+#include <utility>
+
+namespace ue_log {
+
+namespace {
+
+// Limits that keep compilation bounded; patterns beyond them fall back to std::regex
+constexpr int kMaxRepeatCount = 1000;
+constexpr size_t kMaxProgramSize = 20000;
+constexpr size_t kMaxDfaStates = 2000;
+constexpr size_t kMaxDfaTableSize = 1 << 20;
+
+inline bool IsWordByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+std::bitset<256> MakeDigitSet() {
+    std::bitset<256> set;
+    for (int c = '0'; c <= '9'; ++c) set.set(c);
+    return set;
+}
+
+std::bitset<256> MakeWordSet() {
+    std::bitset<256> set;
+    for (int c = 0; c < 256; ++c) {
+        if (IsWordByte(static_cast<unsigned char>(c))) set.set(c);
+    }
+    return set;
+}
+
+std::bitset<256> MakeSpaceSet() {
+    std::bitset<256> set;
+    for (char c : {' ', '\t', '\n', '\v', '\f', '\r'}) set.set(static_cast<unsigned char>(c));
+    return set;
+}
+
+void FoldCase(std::bitset<256>& set) {
+    for (int c = 'a'; c <= 'z'; ++c) {
+        int upper = c - 'a' + 'A';
+        if (set.test(c) || set.test(upper)) {
+            set.set(c);
+            set.set(upper);
+        }
+    }
+}
+
+int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// Parsed pattern tree
+struct RegexNode {
+    enum class Kind { Empty, ByteSet, Concat, Alternate, Repeat, AssertBegin, AssertEnd, WordBoundary, NotWordBoundary };
+
+    Kind kind = Kind::Empty;
+    std::bitset<256> bytes;
+    std::vector<RegexNode> children;
+    int min = 0;
+    int max = -1; // -1 means unbounded
+};
+
+// Recursive-descent parser; any failure (invalid or unsupported syntax) aborts the whole parse
+class RegexParser {
+public:
+    RegexParser(std::string_view pattern, bool case_insensitive)
+        : pattern_(pattern), case_insensitive_(case_insensitive) {}
+
+    bool Parse(RegexNode& root) {
+        root = ParseAlternation();
+        return ok_ && pos_ == pattern_.size();
+    }
+
+private:
+    std::string_view pattern_;
+    bool case_insensitive_;
+    size_t pos_ = 0;
+    bool ok_ = true;
+
+    bool AtEnd() const { return pos_ >= pattern_.size(); }
+    char Peek() const { return pattern_[pos_]; }
+
+    RegexNode Fail() {
+        ok_ = false;
+        pos_ = pattern_.size();
+        return RegexNode();
+    }
+
+    RegexNode MakeSet(std::bitset<256> bytes) {
+        if (case_insensitive_) {
+            FoldCase(bytes);
+        }
+        RegexNode node;
+        node.kind = RegexNode::Kind::ByteSet;
+        node.bytes = bytes;
+        return node;
+    }
+
+    RegexNode MakeByte(unsigned char c) {
+        std::bitset<256> bytes;
+        bytes.set(c);
+        return MakeSet(bytes);
+    }
+
+    RegexNode ParseAlternation() {
+        RegexNode first = ParseConcat();
+        if (!ok_ || AtEnd() || Peek() != '|') {
+            return first;
+        }
+
+        RegexNode node;
+        node.kind = RegexNode::Kind::Alternate;
+        node.children.push_back(std::move(first));
+        while (ok_ && !AtEnd() && Peek() == '|') {
+            ++pos_;
+            node.children.push_back(ParseConcat());
+        }
+        return node;
+    }
+
+    RegexNode ParseConcat() {
+        RegexNode node;
+        node.kind = RegexNode::Kind::Concat;
+        while (ok_ && !AtEnd() && Peek() != '|' && Peek() != ')') {
+            node.children.push_back(ParseQuantified());
+        }
+        return node;
+    }
+
+    RegexNode ParseQuantified() {
+        RegexNode atom = ParseAtom();
+        if (!ok_ || AtEnd()) {
+            return atom;
+        }
+
+        int min = 0;
+        int max = -1;
+        char c = Peek();
+        if (c == '*') {
+            ++pos_;
+        } else if (c == '+') {
+            min = 1;
+            ++pos_;
+        } else if (c == '?') {
+            max = 1;
+            ++pos_;
+        } else if (c == '{') {
+            if (!ParseBraces(min, max)) {
+                return Fail();
+            }
+        } else {
+            return atom;
+        }
+
+        // Assertions cannot be repeated
+        if (atom.kind == RegexNode::Kind::AssertBegin || atom.kind == RegexNode::Kind::AssertEnd ||
+            atom.kind == RegexNode::Kind::WordBoundary || atom.kind == RegexNode::Kind::NotWordBoundary) {
+            return Fail();
+        }
+
+        // Lazy quantifiers match the same strings; only the preferred match differs
+        if (!AtEnd() && Peek() == '?') {
+            ++pos_;
+        }
+
+        // Stacked quantifiers such as a** are rejected
+        if (!AtEnd() && (Peek() == '*' || Peek() == '+' || Peek() == '?' || Peek() == '{')) {
+            return Fail();
+        }
+
+        RegexNode node;
+        node.kind = RegexNode::Kind::Repeat;
+        node.min = min;
+        node.max = max;
+        node.children.push_back(std::move(atom));
+        return node;
+    }
+
+    bool ParseNumber(int& value) {
+        size_t start = pos_;
+        value = 0;
+        while (!AtEnd() && Peek() >= '0' && Peek() <= '9') {
+            value = value * 10 + (Peek() - '0');
+            if (value > kMaxRepeatCount) {
+                return false;
+            }
+            ++pos_;
+        }
+        return pos_ > start;
+    }
+
+    bool ParseBraces(int& min, int& max) {
+        ++pos_; // '{'
+        if (!ParseNumber(min)) {
+            return false;
+        }
+        max = min;
+        if (!AtEnd() && Peek() == ',') {
+            ++pos_;
+            max = -1;
+            if (!AtEnd() && Peek() != '}' && !ParseNumber(max)) {
+                return false;
+            }
+        }
+        if (AtEnd() || Peek() != '}') {
+            return false;
+        }
+        ++pos_;
+        return max == -1 || max >= min;
+    }
+
+    RegexNode ParseAtom() {
+        char c = Peek();
+        switch (c) {
+            case '(': {
+                ++pos_;
+                if (!AtEnd() && Peek() == '?') {
+                    // Only non-capturing groups; lookaround is unsupported
+                    if (pos_ + 1 < pattern_.size() && pattern_[pos_ + 1] == ':') {
+                        pos_ += 2;
+                    } else {
+                        return Fail();
+                    }
+                }
+                RegexNode inner = ParseAlternation();
+                if (!ok_ || AtEnd() || Peek() != ')') {
+                    return Fail();
+                }
+                ++pos_;
+                return inner;
+            }
+            case '[':
+                return ParseClass();
+            case '.': {
+                ++pos_;
+                std::bitset<256> bytes;
+                bytes.set();
+                bytes.reset('\n');
+                bytes.reset('\r');
+                return MakeSet(bytes);
+            }
+            case '^': {
+                ++pos_;
+                RegexNode node;
+                node.kind = RegexNode::Kind::AssertBegin;
+                return node;
+            }
+            case '$': {
+                ++pos_;
+                RegexNode node;
+                node.kind = RegexNode::Kind::AssertEnd;
+                return node;
+            }
+            case '\\':
+                return ParseEscape();
+            case '*':
+            case '+':
+            case '?':
+            case '{':
+            case '}':
+            case ']':
+            case ')':
+                return Fail(); // Nothing to repeat, or left to std::regex to judge
+            default:
+                ++pos_;
+                return MakeByte(static_cast<unsigned char>(c));
+        }
+    }
+
+    // Parses the escape after a backslash into a byte set; returns false for unsupported escapes.
+    // Word boundaries are handled by the caller since they are only valid outside classes.
+    bool ParseEscapedSet(bool in_class, std::bitset<256>& bytes) {
+        if (AtEnd()) {
+            return false;
+        }
+        char c = Peek();
+        ++pos_;
+        bytes.reset();
+        switch (c) {
+            case 'd': bytes = MakeDigitSet(); return true;
+            case 'D': bytes = ~MakeDigitSet(); return true;
+            case 'w': bytes = MakeWordSet(); return true;
+            case 'W': bytes = ~MakeWordSet(); return true;
+            case 's': bytes = MakeSpaceSet(); return true;
+            case 'S': bytes = ~MakeSpaceSet(); return true;
+            case 'n': bytes.set('\n'); return true;
+            case 't': bytes.set('\t'); return true;
+            case 'r': bytes.set('\r'); return true;
+            case 'f': bytes.set('\f'); return true;
+            case 'v': bytes.set('\v'); return true;
+            case 'b':
+                if (in_class) {
+                    bytes.set('\b');
+                    return true;
+                }
+                return false;
+            case '0':
+                if (!AtEnd() && Peek() >= '0' && Peek() <= '9') {
+                    return false;
+                }
+                bytes.set(0);
+                return true;
+            case 'x': {
+                if (pos_ + 2 > pattern_.size()) {
+                    return false;
+                }
+                int high = HexValue(pattern_[pos_]);
+                int low = HexValue(pattern_[pos_ + 1]);
+                if (high < 0 || low < 0) {
+                    return false;
+                }
+                pos_ += 2;
+                bytes.set(static_cast<size_t>(high * 16 + low));
+                return true;
+            }
+            default:
+                // Backreferences, \c, \u, \k and unknown letter escapes are left to std::regex
+                if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+                    return false;
+                }
+                bytes.set(static_cast<unsigned char>(c));
+                return true;
+        }
+    }
+
+    RegexNode ParseEscape() {
+        ++pos_; // '\\'
+        if (!AtEnd() && (Peek() == 'b' || Peek() == 'B')) {
+            RegexNode node;
+            node.kind = Peek() == 'b' ? RegexNode::Kind::WordBoundary : RegexNode::Kind::NotWordBoundary;
+            ++pos_;
+            return node;
+        }
+        std::bitset<256> bytes;
+        if (!ParseEscapedSet(false, bytes)) {
+            return Fail();
+        }
+        return MakeSet(bytes);
+    }
+
+    RegexNode ParseClass() {
+        ++pos_; // '['
+        bool negated = false;
+        if (!AtEnd() && Peek() == '^') {
+            negated = true;
+            ++pos_;
+        }
+        // Empty classes ([] and [^]) are left to std::regex
+        if (AtEnd() || Peek() == ']') {
+            return Fail();
+        }
+
+        std::bitset<256> bytes;
+        while (!AtEnd() && Peek() != ']') {
+            std::bitset<256> item;
+            int low = -1;
+            if (!ParseClassItem(item, low)) {
+                return Fail();
+            }
+
+            // Range such as a-z (a trailing '-' is a literal)
+            if (low >= 0 && pos_ + 1 < pattern_.size() && Peek() == '-' && pattern_[pos_ + 1] != ']') {
+                ++pos_;
+                std::bitset<256> high_item;
+                int high = -1;
+                if (!ParseClassItem(high_item, high) || high < 0 || high < low) {
+                    return Fail();
+                }
+                for (int b = low; b <= high; ++b) {
+                    item.set(static_cast<size_t>(b));
+                }
+            }
+            bytes |= item;
+        }
+        if (AtEnd()) {
+            return Fail();
+        }
+        ++pos_; // ']'
+
+        if (case_insensitive_) {
+            FoldCase(bytes);
+        }
+        if (negated) {
+            bytes = ~bytes;
+        }
+
+        RegexNode node;
+        node.kind = RegexNode::Kind::ByteSet;
+        node.bytes = bytes;
+        return node;
+    }
+
+    // Parses one class member; single_byte is set when the member is one byte (usable in a range)
+    bool ParseClassItem(std::bitset<256>& item, int& single_byte) {
+        char c = Peek();
+        single_byte = -1;
+        item.reset();
+        if (c == '\\') {
+            ++pos_;
+            if (!ParseEscapedSet(true, item)) {
+                return false;
+            }
+            if (item.count() == 1) {
+                for (int b = 0; b < 256; ++b) {
+                    if (item.test(static_cast<size_t>(b))) {
+                        single_byte = b;
+                        break;
+                    }
+                }
+            }
+            return true;
+        }
+        // POSIX classes ([:alpha:], [.x.], [=x=]) are left to std::regex
+        if (c == '[' && pos_ + 1 < pattern_.size() &&
+            (pattern_[pos_ + 1] == ':' || pattern_[pos_ + 1] == '.' || pattern_[pos_ + 1] == '=')) {
+            return false;
+        }
+        ++pos_;
+        single_byte = static_cast<unsigned char>(c);
+        item.set(static_cast<size_t>(single_byte));
+        return true;
+    }
+};
+
+} // namespace
+
+// Lowers a parsed tree to the instruction program of a LinearRegex
+class LinearRegexCompiler {
+public:
+    explicit LinearRegexCompiler(LinearRegex& regex) : regex_(regex) {}
+
+    bool Compile(const RegexNode& root) {
+        Emit(root);
+        Push(LinearRegex::OpCode::Match);
+        return ok_;
+    }
+
+private:
+    LinearRegex& regex_;
+    bool ok_ = true;
+
+    int Push(LinearRegex::OpCode op, int argument = 0) {
+        if (regex_.program_.size() >= kMaxProgramSize) {
+            ok_ = false;
+        }
+        LinearRegex::Instruction instruction;
+        instruction.op = op;
+        instruction.argument = argument;
+        instruction.next = static_cast<int>(regex_.program_.size()) + 1;
+        regex_.program_.push_back(instruction);
+        return static_cast<int>(regex_.program_.size()) - 1;
+    }
+
+    int Here() const { return static_cast<int>(regex_.program_.size()); }
+
+    void Emit(const RegexNode& node) {
+        if (!ok_) {
+            return;
+        }
+        switch (node.kind) {
+            case RegexNode::Kind::Empty:
+                break;
+            case RegexNode::Kind::ByteSet:
+                regex_.byte_sets_.push_back(node.bytes);
+                Push(LinearRegex::OpCode::ByteSet, static_cast<int>(regex_.byte_sets_.size()) - 1);
+                break;
+            case RegexNode::Kind::Concat:
+                for (const auto& child : node.children) {
+                    Emit(child);
+                }
+                break;
+            case RegexNode::Kind::Alternate: {
+                std::vector<int> jumps;
+                for (size_t i = 0; i < node.children.size(); ++i) {
+                    if (i + 1 < node.children.size()) {
+                        int split = Push(LinearRegex::OpCode::Split);
+                        Emit(node.children[i]);
+                        jumps.push_back(Push(LinearRegex::OpCode::Jump));
+                        if (!ok_) return;
+                        regex_.program_[split].alternate = Here();
+                    } else {
+                        Emit(node.children[i]);
+                    }
+                }
+                if (!ok_) return;
+                for (int jump : jumps) {
+                    regex_.program_[jump].next = Here();
+                }
+                break;
+            }
+            case RegexNode::Kind::Repeat: {
+                const RegexNode& child = node.children.front();
+                for (int i = 0; i < node.min; ++i) {
+                    Emit(child);
+                }
+                if (node.max < 0) {
+                    // child* after the mandatory copies
+                    int split = Push(LinearRegex::OpCode::Split);
+                    Emit(child);
+                    int jump = Push(LinearRegex::OpCode::Jump);
+                    if (!ok_) return;
+                    regex_.program_[jump].next = split;
+                    regex_.program_[split].alternate = Here();
+                } else {
+                    // Optional copies; skipping one skips the rest
+                    std::vector<int> splits;
+                    for (int i = node.min; i < node.max; ++i) {
+                        splits.push_back(Push(LinearRegex::OpCode::Split));
+                        Emit(child);
+                    }
+                    if (!ok_) return;
+                    for (int split : splits) {
+                        regex_.program_[split].alternate = Here();
+                    }
+                }
+                break;
+            }
+            case RegexNode::Kind::AssertBegin:
+                Push(LinearRegex::OpCode::AssertBegin);
+                break;
+            case RegexNode::Kind::AssertEnd:
+                Push(LinearRegex::OpCode::AssertEnd);
+                break;
+            case RegexNode::Kind::WordBoundary:
+                regex_.has_word_boundaries_ = true;
+                Push(LinearRegex::OpCode::WordBoundary);
+                break;
+            case RegexNode::Kind::NotWordBoundary:
+                regex_.has_word_boundaries_ = true;
+                Push(LinearRegex::OpCode::NotWordBoundary);
+                break;
+        }
+    }
+};
+
+std::unique_ptr<LinearRegex> LinearRegex::TryCompile(std::string_view pattern, bool case_insensitive) {
+    RegexNode root;
+    RegexParser parser(pattern, case_insensitive);
+    if (!parser.Parse(root)) {
+        return nullptr;
+    }
+
+    std::unique_ptr<LinearRegex> regex(new LinearRegex());
+    LinearRegexCompiler compiler(*regex);
+    if (!compiler.Compile(root)) {
+        return nullptr;
+    }
+
+    // Word boundaries depend on the next byte, which a plain DFA step cannot see
+    if (!regex->has_word_boundaries_ && !regex->BuildDfa()) {
+        regex->dfa_transitions_.clear();
+        regex->dfa_accepting_.clear();
+        regex->dfa_accepting_at_end_.clear();
+    }
+    return regex;
+}
+
+void LinearRegex::Closure(const std::vector<int>& kernel, const Context& context,
+                          std::vector<int>& stack, std::vector<int>& marks, int mark,
+                          std::vector<int>& out) const {
+    out.clear();
+    stack.assign(kernel.rbegin(), kernel.rend());
+    while (!stack.empty()) {
+        int pc = stack.back();
+        stack.pop_back();
+        if (marks[pc] == mark) {
+            continue;
+        }
+        marks[pc] = mark;
+        out.push_back(pc);
+
+        const Instruction& instruction = program_[pc];
+        switch (instruction.op) {
+            case OpCode::Jump:
+                stack.push_back(instruction.next);
+                break;
+            case OpCode::Split:
+                stack.push_back(instruction.alternate);
+                stack.push_back(instruction.next);
+                break;
+            case OpCode::AssertBegin:
+                if (context.at_begin) stack.push_back(instruction.next);
+                break;
+            case OpCode::AssertEnd:
+                if (context.at_end) stack.push_back(instruction.next);
+                break;
+            case OpCode::WordBoundary:
+                if (context.previous_is_word != context.next_is_word) stack.push_back(instruction.next);
+                break;
+            case OpCode::NotWordBoundary:
+                if (context.previous_is_word == context.next_is_word) stack.push_back(instruction.next);
+                break;
+            case OpCode::ByteSet:
+            case OpCode::Match:
+                break;
+        }
+    }
+}
+
+bool LinearRegex::BuildDfa() {
+    // Group bytes that every byte set treats the same way
+    std::map<std::vector<bool>, int> class_ids;
+    byte_classes_.assign(256, 0);
+    std::vector<unsigned char> representatives;
+    for (int b = 0; b < 256; ++b) {
+        std::vector<bool> signature(byte_sets_.size());
+        for (size_t s = 0; s < byte_sets_.size(); ++s) {
+            signature[s] = byte_sets_[s].test(static_cast<size_t>(b));
+        }
+        auto inserted = class_ids.emplace(std::move(signature), static_cast<int>(class_ids.size()));
+        if (inserted.second) {
+            representatives.push_back(static_cast<unsigned char>(b));
+        }
+        byte_classes_[b] = static_cast<unsigned char>(inserted.first->second);
+    }
+    class_count_ = static_cast<int>(representatives.size());
+
+    // DFA states are (at_begin, sorted NFA kernel); the start pc is in every kernel for unanchored search
+    using StateKey = std::pair<bool, std::vector<int>>;
+    std::map<StateKey, int> state_ids;
+    std::vector<StateKey> pending;
+
+    auto get_state = [&](StateKey key) -> int {
+        auto it = state_ids.find(key);
+        if (it != state_ids.end()) {
+            return it->second;
+        }
+        int id = static_cast<int>(state_ids.size());
+        state_ids.emplace(key, id);
+        pending.push_back(std::move(key));
+        return id;
+    };
+
+    std::vector<int> marks(program_.size(), 0);
+    int mark = 0;
+    std::vector<int> stack;
+    std::vector<int> closure;
+
+    dfa_start_ = get_state(StateKey(true, std::vector<int>{0}));
+    for (size_t state = 0; state < pending.size(); ++state) {
+        if (pending.size() > kMaxDfaStates ||
+            pending.size() * static_cast<size_t>(class_count_) > kMaxDfaTableSize) {
+            return false;
+        }
+
+        StateKey key = pending[state];
+        Context context;
+        context.at_begin = key.first;
+
+        Closure(key.second, context, stack, marks, ++mark, closure);
+        bool accepting = std::any_of(closure.begin(), closure.end(),
+            [this](int pc) { return program_[pc].op == OpCode::Match; });
+
+        Context end_context = context;
+        end_context.at_end = true;
+        std::vector<int> end_closure;
+        Closure(key.second, end_context, stack, marks, ++mark, end_closure);
+        bool accepting_at_end = std::any_of(end_closure.begin(), end_closure.end(),
+            [this](int pc) { return program_[pc].op == OpCode::Match; });
+
+        dfa_accepting_.push_back(accepting);
+        dfa_accepting_at_end_.push_back(accepting_at_end);
+        dfa_transitions_.resize(dfa_accepting_.size() * static_cast<size_t>(class_count_), static_cast<int>(state));
+
+        // Accepting states end the search, so they need no transitions
+        if (accepting) {
+            continue;
+        }
+
+        for (int byte_class = 0; byte_class < class_count_; ++byte_class) {
+            unsigned char byte = representatives[byte_class];
+            std::vector<int> next_kernel{0};
+            for (int pc : closure) {
+                const Instruction& instruction = program_[pc];
+                if (instruction.op == OpCode::ByteSet && byte_sets_[instruction.argument].test(byte)) {
+                    next_kernel.push_back(instruction.next);
+                }
+            }
+            std::sort(next_kernel.begin(), next_kernel.end());
+            next_kernel.erase(std::unique(next_kernel.begin(), next_kernel.end()), next_kernel.end());
+
+            int next_state = get_state(StateKey(false, std::move(next_kernel)));
+            dfa_transitions_[state * static_cast<size_t>(class_count_) + byte_class] = next_state;
+        }
+    }
+    return true;
+}
+
+bool LinearRegex::Search(std::string_view text) const {
+    if (!HasDfa()) {
+        return SearchNfa(text);
+    }
+
+    int state = dfa_start_;
+    for (char c : text) {
+        if (dfa_accepting_[state]) {
+            return true;
+        }
+        state = dfa_transitions_[static_cast<size_t>(state) * class_count_ + byte_classes_[static_cast<unsigned char>(c)]];
+    }
+    return dfa_accepting_at_end_[state];
+}
+
+bool LinearRegex::SearchNfa(std::string_view text) const {
+    // Per-thread scratch buffers, so concurrent searches never allocate after warm-up
+    thread_local std::vector<int> marks;
+    thread_local std::vector<int> stack;
+    thread_local std::vector<int> kernel;
+    thread_local std::vector<int> closure;
+    thread_local int mark = 0;
+
+    if (marks.size() < program_.size()) {
+        marks.assign(program_.size(), 0);
+        mark = 0;
+    }
+
+    kernel.clear();
+    for (size_t i = 0; i <= text.size(); ++i) {
+        Context context;
+        context.at_begin = i == 0;
+        context.at_end = i == text.size();
+        context.previous_is_word = i > 0 && IsWordByte(static_cast<unsigned char>(text[i - 1]));
+        context.next_is_word = i < text.size() && IsWordByte(static_cast<unsigned char>(text[i]));
+
+        // Start a new thread at every position (unanchored search)
+        kernel.push_back(0);
+        if (mark == std::numeric_limits<int>::max()) {
+            std::fill(marks.begin(), marks.end(), 0);
+            mark = 0;
+        }
+        ++mark;
+        Closure(kernel, context, stack, marks, mark, closure);
+
+        kernel.clear();
+        for (int pc : closure) {
+            const Instruction& instruction = program_[pc];
+            if (instruction.op == OpCode::Match) {
+                return true;
+            }
+            if (i < text.size() && instruction.op == OpCode::ByteSet &&
+                byte_sets_[instruction.argument].test(static_cast<unsigned char>(text[i]))) {
+                kernel.push_back(instruction.next);
+            }
+        }
+    }
+    return false;
+}
+
+} // namespace ue_log
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <bitset>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Regex engine with linear-time matching: the pattern is compiled to a Thompson NFA, which is
+ * converted to a DFA up front when the DFA stays small and simulated directly otherwise.
+ * Matching never backtracks, so user-entered patterns cannot take exponential time.
+ *
+ * Supported syntax is the commonly used ECMAScript subset: literals and escapes, '.', character
+ * classes (with \d \w \s and their negations), groups and non-capturing groups, alternation,
+ * greedy and lazy quantifiers (* + ? {n} {n,} {n,m}), and the ^ $ \b \B assertions.
+ * Backreferences, lookaround and POSIX classes are not supported; TryCompile returns nullptr
+ * for those (and for invalid patterns) so the caller can fall back to std::regex.
+ */
+class LinearRegex {
+public:
+    /**
+     * Compile a pattern.
+     * @param pattern ECMAScript-style pattern
+     * @param case_insensitive Whether ASCII letters match regardless of case
+     * @return Compiled regex, or nullptr if the pattern is invalid or uses unsupported syntax
+     */
+    static std::unique_ptr<LinearRegex> TryCompile(std::string_view pattern, bool case_insensitive);
+
+    /**
+     * Check if the pattern matches anywhere in the text. Safe to call from several threads.
+     * @param text Text to search
+     * @return True if there is a match
+     */
+    bool Search(std::string_view text) const;
+
+    /**
+     * Check if matching runs on the precomputed DFA (as opposed to NFA simulation).
+     * @return True if a DFA was built
+     */
+    bool HasDfa() const { return !dfa_accepting_.empty(); }
+
+private:
+    LinearRegex() = default;
+
+    enum class OpCode {
+        ByteSet,           // Consume one byte contained in byte_sets_[argument]
+        Split,             // Continue at both next and alternate
+        Jump,              // Continue at next
+        AssertBegin,       // Zero-width: start of text
+        AssertEnd,         // Zero-width: end of text
+        WordBoundary,      // Zero-width: \b
+        NotWordBoundary,   // Zero-width: \B
+        Match
+    };
+
+    struct Instruction {
+        OpCode op = OpCode::Match;
+        int next = 0;
+        int alternate = 0;
+        int argument = 0;
+    };
+
+    // Position context for evaluating zero-width assertions
+    struct Context {
+        bool at_begin = false;
+        bool at_end = false;
+        bool previous_is_word = false;
+        bool next_is_word = false;
+    };
+
+    std::vector<Instruction> program_;
+    std::vector<std::bitset<256>> byte_sets_;
+    bool has_word_boundaries_ = false;
+
+    // DFA over byte equivalence classes (empty when NFA simulation is used)
+    std::vector<unsigned char> byte_classes_;
+    int class_count_ = 0;
+    int dfa_start_ = 0;
+    std::vector<int> dfa_transitions_;      // state * class_count_ + class
+    std::vector<bool> dfa_accepting_;       // Match reachable before consuming more input
+    std::vector<bool> dfa_accepting_at_end_; // Match reachable at the end of the text
+
+    friend class LinearRegexCompiler;
+
+    void Closure(const std::vector<int>& kernel, const Context& context,
+                 std::vector<int>& stack, std::vector<int>& marks, int mark,
+                 std::vector<int>& out) const;
+    bool BuildDfa();
+    bool SearchNfa(std::string_view text) const;
+};
+
+} // namespace ue_log
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace ue_log {
+
+/**
+ * Stable hash (32-bit FNV-1a) of a logger name, used to pick its badge color.
+ * Computed once per logger by LogCategoryIndex; the theme maps it onto its palette.
+ * @param logger_name Logger name
+ * @return Color key, the same for the same name in every session
+ */
+inline uint32_t ComputeLoggerColorKey(std::string_view logger_name) {
+    uint32_t hash = 2166136261u;
+    for (char c : logger_name) {
+        hash = (hash ^ static_cast<unsigned char>(c)) * 16777619u;
+    }
+    return hash;
+}
+
+} // namespace ue_log
@@ -0,0 +1,198 @@
+#include "multi_pattern_matcher.h"
+#include <algorithm>
+#include <queue>
+
+namespace ue_log {
+
+namespace {
+
+inline unsigned char FoldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+// Per-thread "seen" stamps used to report each pattern once per text without clearing a set
+struct MatchScratch {
+    std::vector<uint32_t> stamps;
+    uint32_t stamp = 0;
+
+    uint32_t Begin(size_t pattern_count) {
+        if (stamps.size() < pattern_count || stamp == UINT32_MAX) {
+            stamps.assign(std::max(stamps.size(), pattern_count), 0);
+            stamp = 0;
+        }
+        return ++stamp;
+    }
+};
+
+MatchScratch& GetScratch() {
+    thread_local MatchScratch scratch;
+    return scratch;
+}
+
+} // namespace
+
+MultiPatternMatcher::MultiPatternMatcher(const std::vector<std::string>& patterns, bool case_sensitive)
+    : pattern_count_(patterns.size()) {
+    // Class 0 holds every byte that occurs in no pattern
+    bool used[256] = {};
+    size_t distinct = 0;
+    for (const auto& pattern : patterns) {
+        for (char c : pattern) {
+            unsigned char byte = static_cast<unsigned char>(c);
+            if (!case_sensitive) {
+                byte = FoldAscii(byte);
+            }
+            if (!used[byte]) {
+                used[byte] = true;
+                ++distinct;
+            }
+        }
+    }
+
+    if (distinct == 256) {
+        class_count_ = 256;
+        for (int b = 0; b < 256; ++b) {
+            byte_classes_[b] = static_cast<unsigned char>(b);
+        }
+    } else {
+        class_count_ = 1;
+        for (int b = 0; b < 256; ++b) {
+            if (used[b]) {
+                byte_classes_[b] = static_cast<unsigned char>(class_count_++);
+            }
+        }
+        if (!case_sensitive) {
+            for (int c = 'A'; c <= 'Z'; ++c) {
+                byte_classes_[c] = byte_classes_[c | 0x20];
+            }
+        }
+    }
+
+    // Trie
+    std::vector<std::vector<uint32_t>> outputs(1);
+    transitions_.assign(class_count_, -1);
+    for (size_t id = 0; id < patterns.size(); ++id) {
+        int32_t state = 0;
+        for (char c : patterns[id]) {
+            size_t slot = static_cast<size_t>(state) * class_count_ + byte_classes_[static_cast<unsigned char>(c)];
+            if (transitions_[slot] < 0) {
+                transitions_[slot] = static_cast<int32_t>(outputs.size());
+                outputs.emplace_back();
+                transitions_.resize(outputs.size() * class_count_, -1);
+            }
+            state = transitions_[slot];
+        }
+        outputs[state].push_back(static_cast<uint32_t>(id));
+    }
+
+    // Breadth-first failure links, completing the trie into a DFA as we go
+    std::vector<int32_t> fail(outputs.size(), 0);
+    std::queue<int32_t> pending;
+    for (size_t c = 0; c < class_count_; ++c) {
+        int32_t& next = transitions_[c];
+        if (next < 0) {
+            next = 0;
+        } else {
+            pending.push(next);
+        }
+    }
+    while (!pending.empty()) {
+        int32_t state = pending.front();
+        pending.pop();
+
+        const auto& inherited = outputs[fail[state]];
+        outputs[state].insert(outputs[state].end(), inherited.begin(), inherited.end());
+
+        for (size_t c = 0; c < class_count_; ++c) {
+            size_t slot = static_cast<size_t>(state) * class_count_ + c;
+            int32_t fallback = transitions_[static_cast<size_t>(fail[state]) * class_count_ + c];
+            if (transitions_[slot] < 0) {
+                transitions_[slot] = fallback;
+            } else {
+                fail[transitions_[slot]] = fallback;
+                pending.push(transitions_[slot]);
+            }
+        }
+    }
+
+    output_offsets_.reserve(outputs.size() + 1);
+    output_offsets_.push_back(0);
+    for (const auto& state_outputs : outputs) {
+        output_ids_.insert(output_ids_.end(), state_outputs.begin(), state_outputs.end());
+        output_offsets_.push_back(static_cast<uint32_t>(output_ids_.size()));
+    }
+}
+
+template<typename OnOutput>
+void MultiPatternMatcher::Scan(std::string_view text, OnOutput&& on_output) const {
+    if (pattern_count_ == 0) {
+        return;
+    }
+
+    // The root only has outputs for empty patterns, which match every text
+    if (output_offsets_[1] != 0 && !on_output(0)) {
+        return;
+    }
+
+    const int32_t* transitions = transitions_.data();
+    const uint32_t* offsets = output_offsets_.data();
+    int32_t state = 0;
+    for (char c : text) {
+        state = transitions[static_cast<size_t>(state) * class_count_ + byte_classes_[static_cast<unsigned char>(c)]];
+        if (offsets[state + 1] != offsets[state] && !on_output(state)) {
+            return;
+        }
+    }
+}
+
+bool MultiPatternMatcher::ContainsAny(std::string_view text) const {
+    bool found = false;
+    Scan(text, [&found](int32_t) {
+        found = true;
+        return false;
+    });
+    return found;
+}
+
+bool MultiPatternMatcher::ContainsAll(std::string_view text) const {
+    if (pattern_count_ == 0) {
+        return true;
+    }
+
+    MatchScratch& scratch = GetScratch();
+    const uint32_t stamp = scratch.Begin(pattern_count_);
+    size_t seen = 0;
+    Scan(text, [&](int32_t state) {
+        for (uint32_t i = output_offsets_[state]; i < output_offsets_[state + 1]; ++i) {
+            uint32_t& mark = scratch.stamps[output_ids_[i]];
+            if (mark != stamp) {
+                mark = stamp;
+                ++seen;
+            }
+        }
+        return seen < pattern_count_;
+    });
+    return seen == pattern_count_;
+}
+
+void MultiPatternMatcher::FindMatches(std::string_view text, std::vector<size_t>& matched_ids) const {
+    matched_ids.clear();
+    if (pattern_count_ == 0) {
+        return;
+    }
+
+    MatchScratch& scratch = GetScratch();
+    const uint32_t stamp = scratch.Begin(pattern_count_);
+    Scan(text, [&](int32_t state) {
+        for (uint32_t i = output_offsets_[state]; i < output_offsets_[state + 1]; ++i) {
+            uint32_t& mark = scratch.stamps[output_ids_[i]];
+            if (mark != stamp) {
+                mark = stamp;
+                matched_ids.push_back(output_ids_[i]);
+            }
+        }
+        return matched_ids.size() < pattern_count_;
+    });
+}
+
+} // namespace ue_log
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Aho-Corasick automaton over a set of literal patterns. One pass over the text finds every
+ * pattern it contains, so the cost per text is independent of the number of patterns.
+ * Transitions are stored as a dense table over the byte classes that occur in the patterns.
+ */
+class MultiPatternMatcher {
+public:
+    MultiPatternMatcher() = default;
+
+    /**
+     * Build the automaton.
+     * @param patterns Literal patterns; the pattern id is the index in this vector
+     * @param case_sensitive Whether matching is case sensitive (ASCII folding otherwise)
+     */
+    MultiPatternMatcher(const std::vector<std::string>& patterns, bool case_sensitive);
+
+    /**
+     * Check if the text contains at least one pattern. Stops at the first match.
+     * @param text Text to search
+     * @return True if any pattern occurs in the text
+     */
+    bool ContainsAny(std::string_view text) const;
+
+    /**
+     * Check if the text contains every pattern. Stops as soon as all have been seen.
+     * @param text Text to search
+     * @return True if all patterns occur in the text
+     */
+    bool ContainsAll(std::string_view text) const;
+
+    /**
+     * Collect the ids of all patterns that occur in the text, each reported once.
+     * Safe to call from several threads.
+     * @param text Text to search
+     * @param matched_ids Receives the matching pattern ids (cleared first)
+     */
+    void FindMatches(std::string_view text, std::vector<size_t>& matched_ids) const;
+
+    size_t GetPatternCount() const { return pattern_count_; }
+    size_t GetStateCount() const { return output_offsets_.empty() ? 0 : output_offsets_.size() - 1; }
+    bool IsEmpty() const { return pattern_count_ == 0; }
+
+private:
+    size_t pattern_count_ = 0;
+    size_t class_count_ = 0;
+    unsigned char byte_classes_[256] = {};
+    std::vector<int32_t> transitions_;     // state * class_count_ + class -> state
+    std::vector<uint32_t> output_offsets_; // Outputs of state s are output_ids_[offsets[s], offsets[s + 1])
+    std::vector<uint32_t> output_ids_;     // Pattern ids, including those inherited through failure links
+
+    // Walk the automaton, calling on_output(state) for each state with outputs until it returns false
+    template<typename OnOutput>
+    void Scan(std::string_view text, OnOutput&& on_output) const;
+};
+
+} // namespace ue_log
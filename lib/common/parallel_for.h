@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace ue_log {
+namespace parallel {
+
+/**
+ * Entries per chunk: large enough to amortize scheduling, small enough that chunks stay
+ * cache-resident and the last ones balance out uneven per-entry cost.
+ */
+constexpr size_t kDefaultChunkSize = 4096;
+
+/**
+ * Get the number of threads used for parallel loops (including the calling thread).
+ * @return Hardware concurrency, at least 1
+ */
+inline size_t GetWorkerCount() {
+    unsigned int hardware_threads = std::thread::hardware_concurrency();
+    return hardware_threads == 0 ? 1 : static_cast<size_t>(hardware_threads);
+}
+
+/**
+ * Process [0, count) in chunks on all cores. Idle workers claim the next unprocessed chunk
+ * from a shared cursor, so slow chunks never hold up a whole thread's share of the work.
+ * The calling thread participates and the call returns when every chunk is done.
+ * Small inputs are processed on the calling thread only. The callback must not throw.
+ * @param count Number of items
+ * @param chunk_size Items per chunk
+ * @param process_chunk Called as process_chunk(worker_index, chunk_index, begin, end);
+ *                      worker_index is below the returned worker count
+ * @return Number of workers used (size per-worker accumulators with GetWorkerCount())
+ */
+template<typename ChunkFunction>
+size_t ForEachChunk(size_t count, size_t chunk_size, ChunkFunction&& process_chunk) {
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    const size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+    const size_t worker_count = std::min(GetWorkerCount(), chunk_count);
+
+    std::atomic<size_t> next_chunk{0};
+    auto run_worker = [&](size_t worker_index) {
+        for (size_t chunk = next_chunk.fetch_add(1, std::memory_order_relaxed); chunk < chunk_count;
+             chunk = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+            size_t begin = chunk * chunk_size;
+            process_chunk(worker_index, chunk, begin, std::min(begin + chunk_size, count));
+        }
+    };
+
+    if (worker_count <= 1) {
+        run_worker(0);
+        return 1;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(worker_count - 1);
+    for (size_t worker = 1; worker < worker_count; ++worker) {
+        threads.emplace_back(run_worker, worker);
+    }
+    run_worker(0);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return worker_count;
+}
+
+/**
+ * Evaluate a predicate over [0, count) in parallel and collect the passing indices in order.
+ * Each chunk fills its own buffer; the buffers are concatenated in chunk order afterwards.
+ * @param count Number of items
+ * @param predicate Called as predicate(index) from several threads; must be thread-safe
+ * @param chunk_size Items per chunk
+ * @return Sorted indices for which the predicate returned true
+ */
+template<typename Predicate>
+std::vector<size_t> CollectMatchingIndices(size_t count, Predicate&& predicate,
+                                           size_t chunk_size = kDefaultChunkSize) {
+    chunk_size = std::max<size_t>(chunk_size, 1);
+    const size_t chunk_count = (count + chunk_size - 1) / chunk_size;
+    std::vector<std::vector<size_t>> chunk_matches(chunk_count);
+
+    ForEachChunk(count, chunk_size, [&](size_t, size_t chunk, size_t begin, size_t end) {
+        std::vector<size_t>& matches = chunk_matches[chunk];
+        for (size_t i = begin; i < end; ++i) {
+            if (predicate(i)) {
+                matches.push_back(i);
+            }
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& matches : chunk_matches) {
+        total += matches.size();
+    }
+
+    std::vector<size_t> result;
+    result.reserve(total);
+    for (const auto& matches : chunk_matches) {
+        result.insert(result.end(), matches.begin(), matches.end());
+    }
+    return result;
+}
+
+} // namespace parallel
+} // namespace ue_log
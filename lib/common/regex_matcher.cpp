@@ -0,0 +1,63 @@
+#include "regex_matcher.h"
+#include "linear_regex.h"
+#include <regex>
+
+namespace ue_log {
+
+namespace {
+
+class LinearRegexMatcher : public RegexMatcher {
+public:
+    explicit LinearRegexMatcher(std::unique_ptr<LinearRegex> regex) : regex_(std::move(regex)) {}
+
+    bool Search(std::string_view text) const override {
+        return regex_->Search(text);
+    }
+
+    RegexBackend GetBackend() const override { return RegexBackend::Linear; }
+
+private:
+    std::unique_ptr<LinearRegex> regex_;
+};
+
+class StandardRegexMatcher : public RegexMatcher {
+public:
+    explicit StandardRegexMatcher(std::regex regex) : regex_(std::move(regex)) {}
+
+    bool Search(std::string_view text) const override {
+        try {
+            return std::regex_search(text.begin(), text.end(), regex_);
+        } catch (const std::regex_error&) {
+            return false; // e.g. error_complexity / error_stack on pathological input
+        }
+    }
+
+    RegexBackend GetBackend() const override { return RegexBackend::Standard; }
+
+private:
+    std::regex regex_;
+};
+
+} // namespace
+
+std::unique_ptr<RegexMatcher> RegexMatcher::Compile(const std::string& pattern, bool case_insensitive,
+                                                    RegexBackend preferred) {
+    if (preferred == RegexBackend::Linear) {
+        auto linear = LinearRegex::TryCompile(pattern, case_insensitive);
+        if (linear) {
+            return std::make_unique<LinearRegexMatcher>(std::move(linear));
+        }
+    }
+
+    try {
+        auto flags = std::regex_constants::ECMAScript;
+        if (case_insensitive) {
+            flags |= std::regex_constants::icase;
+        }
+        return std::make_unique<StandardRegexMatcher>(std::regex(pattern, flags));
+    } catch (const std::regex_error&) {
+        return nullptr;
+    }
+}
+
+} // namespace ue_log
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace ue_log {
+
+/**
+ * Regex implementation used to run a compiled pattern.
+ */
+enum class RegexBackend {
+    Linear,    // LinearRegex: no backtracking, time linear in the text length
+    Standard   // std::regex (ECMAScript): full syntax, but backtracking can be exponential
+};
+
+/**
+ * Compiled regex behind a backend-independent interface, used by filters and search.
+ * Compile prefers the linear-time engine, so user-entered patterns cannot hang the UI,
+ * and falls back to std::regex for syntax the linear engine does not support
+ * (backreferences, lookaround, POSIX classes).
+ */
+class RegexMatcher {
+public:
+    virtual ~RegexMatcher() = default;
+
+    /**
+     * Check if the pattern matches anywhere in the text. Safe to call from several threads.
+     * @param text Text to search
+     * @return True if there is a match
+     */
+    virtual bool Search(std::string_view text) const = 0;
+
+    /**
+     * Get the backend that runs this pattern.
+     * @return Backend in use
+     */
+    virtual RegexBackend GetBackend() const = 0;
+
+    /**
+     * Compile a pattern with the preferred backend, falling back to std::regex when needed.
+     * @param pattern ECMAScript-style pattern
+     * @param case_insensitive Whether matching ignores case
+     * @param preferred Backend to try first
+     * @return Compiled matcher, or nullptr if the pattern is invalid
+     */
+    static std::unique_ptr<RegexMatcher> Compile(const std::string& pattern, bool case_insensitive,
+                                                 RegexBackend preferred = RegexBackend::Linear);
+};
+
+} // namespace ue_log
@@ -0,0 +1,154 @@
+#include "string_search.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#define UE_LOG_STRING_SEARCH_SSE2 1
+#include <emmintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+namespace ue_log {
+namespace string_search {
+
+namespace {
+
+inline unsigned char FoldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c | 0x20) : c;
+}
+
+inline unsigned char UpperAscii(unsigned char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<unsigned char>(c & ~0x20) : c;
+}
+
+inline bool EqualsFolded(const char* text, const char* lowered, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        if (FoldAscii(static_cast<unsigned char>(text[i])) != static_cast<unsigned char>(lowered[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+#if defined(UE_LOG_STRING_SEARCH_SSE2)
+inline int CountTrailingZeros(unsigned int value) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(value);
+#endif
+}
+#endif
+
+} // namespace
+
+std::string ToLowerAscii(std::string_view text) {
+    std::string lowered(text);
+    for (char& c : lowered) {
+        c = static_cast<char>(FoldAscii(static_cast<unsigned char>(c)));
+    }
+    return lowered;
+}
+
+bool HasUpperAscii(std::string_view text) {
+    for (char c : text) {
+        if (c >= 'A' && c <= 'Z') {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t FindCaseInsensitive(std::string_view haystack, std::string_view lowered_needle, size_t start) {
+    const size_t needle_length = lowered_needle.size();
+    const size_t haystack_length = haystack.size();
+
+    if (start > haystack_length) {
+        return std::string_view::npos;
+    }
+    if (needle_length == 0) {
+        return start;
+    }
+    if (haystack_length - start < needle_length) {
+        return std::string_view::npos;
+    }
+
+    const char* text = haystack.data();
+    const char* needle = lowered_needle.data();
+    const unsigned char first = static_cast<unsigned char>(needle[0]);
+    const unsigned char last = static_cast<unsigned char>(needle[needle_length - 1]);
+    const size_t last_candidate = haystack_length - needle_length;
+    const size_t middle_length = needle_length > 2 ? needle_length - 2 : 0;
+
+    size_t i = start;
+
+#if defined(UE_LOG_STRING_SEARCH_SSE2)
+    // Compare 16 candidate positions at once against both cases of the first and last needle bytes
+    const __m128i first_lower = _mm_set1_epi8(static_cast<char>(first));
+    const __m128i first_upper = _mm_set1_epi8(static_cast<char>(UpperAscii(first)));
+    const __m128i last_lower = _mm_set1_epi8(static_cast<char>(last));
+    const __m128i last_upper = _mm_set1_epi8(static_cast<char>(UpperAscii(last)));
+
+    for (; i + 16 <= last_candidate + 1; i += 16) {
+        const __m128i block_first = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i));
+        const __m128i block_last = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text + i + needle_length - 1));
+
+        const __m128i eq_first = _mm_or_si128(_mm_cmpeq_epi8(block_first, first_lower),
+                                              _mm_cmpeq_epi8(block_first, first_upper));
+        const __m128i eq_last = _mm_or_si128(_mm_cmpeq_epi8(block_last, last_lower),
+                                             _mm_cmpeq_epi8(block_last, last_upper));
+
+        unsigned int mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last)));
+        while (mask != 0) {
+            const size_t candidate = i + static_cast<size_t>(CountTrailingZeros(mask));
+            if (EqualsFolded(text + candidate + 1, needle + 1, middle_length)) {
+                return candidate;
+            }
+            mask &= mask - 1;
+        }
+    }
+#endif
+
+    // Scalar tail (and the whole search without SSE2)
+    for (; i <= last_candidate; ++i) {
+        if (FoldAscii(static_cast<unsigned char>(text[i])) == first &&
+            FoldAscii(static_cast<unsigned char>(text[i + needle_length - 1])) == last &&
+            EqualsFolded(text + i + 1, needle + 1, middle_length)) {
+            return i;
+        }
+    }
+
+    return std::string_view::npos;
+}
+
+SubstringMatcher::SubstringMatcher(std::string_view needle, bool case_sensitive)
+    : needle_(case_sensitive ? std::string(needle) : ToLowerAscii(needle)),
+      case_sensitive_(case_sensitive) {
+}
+
+size_t SubstringMatcher::Find(std::string_view haystack, size_t start) const {
+    if (case_sensitive_) {
+        return haystack.find(needle_, start);
+    }
+    return FindCaseInsensitive(haystack, needle_, start);
+}
+
+size_t SubstringMatcher::FindAll(std::string_view haystack, std::vector<MatchSpan>& spans) const {
+    if (needle_.empty()) {
+        return 0;
+    }
+
+    size_t count = 0;
+    size_t pos = 0;
+    while ((pos = Find(haystack, pos)) != std::string_view::npos) {
+        spans.push_back(MatchSpan{static_cast<uint32_t>(pos), static_cast<uint32_t>(needle_.size())});
+        pos += needle_.size();
+        ++count;
+    }
+    return count;
+}
+
+} // namespace string_search
+} // namespace ue_log
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ue_log {
+namespace string_search {
+
+/**
+ * Lower-case ASCII letters in a string. Other bytes (including UTF-8 sequences) are copied unchanged,
+ * which matches ::tolower in the default "C" locale.
+ * @param text Text to lower-case
+ * @return Lower-cased copy of the text
+ */
+std::string ToLowerAscii(std::string_view text);
+
+/**
+ * Check if a string contains any ASCII upper-case letter.
+ * @param text Text to check
+ * @return True if at least one character is in 'A'..'Z'
+ */
+bool HasUpperAscii(std::string_view text);
+
+/**
+ * Find the first ASCII case-insensitive occurrence of a needle, without copying the haystack.
+ * Candidates are selected by comparing the needle's first and last bytes (16 positions at a time
+ * when SSE2 is available) before the remaining bytes are compared case-folded.
+ * @param haystack Text to search, in its original case
+ * @param lowered_needle Needle already lower-cased with ToLowerAscii
+ * @param start Offset to start searching from
+ * @return Offset of the match, or std::string_view::npos if there is none
+ */
+size_t FindCaseInsensitive(std::string_view haystack, std::string_view lowered_needle, size_t start = 0);
+
+/**
+ * Check if a haystack contains a needle, ignoring ASCII case.
+ * @param haystack Text to search, in its original case
+ * @param lowered_needle Needle already lower-cased with ToLowerAscii
+ * @return True if the needle occurs in the haystack
+ */
+inline bool ContainsCaseInsensitive(std::string_view haystack, std::string_view lowered_needle) {
+    return FindCaseInsensitive(haystack, lowered_needle) != std::string_view::npos;
+}
+
+/**
+ * Byte range of one match in a haystack, recorded by a search so highlighting does not search again.
+ */
+struct MatchSpan {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+/**
+ * Pre-processed substring query shared by filtering, search and highlighting.
+ * The needle is prepared once, so Find never allocates.
+ */
+class SubstringMatcher {
+public:
+    SubstringMatcher() = default;
+
+    /**
+     * Constructor.
+     * @param needle Text to look for
+     * @param case_sensitive Whether matching is case sensitive
+     */
+    SubstringMatcher(std::string_view needle, bool case_sensitive);
+
+    /**
+     * Find the next occurrence of the needle.
+     * @param haystack Text to search
+     * @param start Offset to start searching from
+     * @return Offset of the match, or std::string_view::npos if there is none
+     */
+    size_t Find(std::string_view haystack, size_t start = 0) const;
+
+    /**
+     * Check if the needle occurs in a haystack.
+     * @param haystack Text to search
+     * @return True if the needle occurs in the haystack
+     */
+    bool Matches(std::string_view haystack) const { return Find(haystack) != std::string_view::npos; }
+
+    /**
+     * Append every non-overlapping occurrence of the needle, in order.
+     * @param haystack Text to search
+     * @param spans Receives the matches
+     * @return Number of matches appended
+     */
+    size_t FindAll(std::string_view haystack, std::vector<MatchSpan>& spans) const;
+
+    const std::string& GetNeedle() const { return needle_; }
+    bool IsCaseSensitive() const { return case_sensitive_; }
+    bool IsEmpty() const { return needle_.empty(); }
+
+private:
+    std::string needle_; // Lower-cased when matching is case insensitive
+    bool case_sensitive_ = false;
+};
+
+} // namespace string_search
+} // namespace ue_log
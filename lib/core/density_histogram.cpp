@@ -0,0 +1,119 @@
+#include "density_histogram.h"
+#include "../common/parallel_for.h"
+#include <algorithm>
+
+namespace ue_log {
+
+DensityHistogram::DensityHistogram(size_t series_count)
+    : series_count_(std::min<size_t>(std::max<size_t>(series_count, 1), 32)) {
+}
+
+void DensityHistogram::Clear() {
+    counts_.clear();
+    row_count_ = 0;
+    rows_per_bucket_ = 1;
+    bucket_count_ = 0;
+    ++generation_;
+}
+
+void DensityHistogram::Append(uint32_t series_mask) {
+    size_t bucket = row_count_ / rows_per_bucket_;
+    if (bucket >= kMaxBuckets) {
+        MergeBucketPairs();
+        bucket = row_count_ / rows_per_bucket_;
+    }
+    if (bucket >= bucket_count_) {
+        bucket_count_ = bucket + 1;
+        counts_.resize(bucket_count_ * series_count_, 0);
+    }
+
+    uint32_t* bucket_counts = &counts_[bucket * series_count_];
+    for (size_t series = 0; series < series_count_ && series_mask != 0; ++series, series_mask >>= 1) {
+        bucket_counts[series] += series_mask & 1u;
+    }
+
+    ++row_count_;
+    ++generation_;
+}
+
+void DensityHistogram::AppendRows(size_t count, const SeriesMaskFunction& series_mask_of) {
+    if (row_count_ != 0 || count < kMinParallelRows) {
+        for (size_t i = 0; i < count; ++i) {
+            Append(series_mask_of(row_count_));
+        }
+        return;
+    }
+
+    // Final bucket width for the whole batch, so no merging is needed afterwards
+    while ((count + rows_per_bucket_ - 1) / rows_per_bucket_ > kMaxBuckets) {
+        rows_per_bucket_ *= 2;
+    }
+    bucket_count_ = (count + rows_per_bucket_ - 1) / rows_per_bucket_;
+    counts_.assign(bucket_count_ * series_count_, 0);
+
+    // Each chunk owns whole buckets, so workers never write to the same counter
+    size_t buckets_per_chunk = std::max<size_t>(1, parallel::kDefaultChunkSize * 4 / rows_per_bucket_);
+    parallel::ForEachChunk(bucket_count_, buckets_per_chunk, [&](size_t, size_t, size_t bucket_begin, size_t bucket_end) {
+        size_t row_end = std::min(count, bucket_end * rows_per_bucket_);
+        for (size_t row = bucket_begin * rows_per_bucket_; row < row_end; ++row) {
+            uint32_t* bucket_counts = &counts_[(row / rows_per_bucket_) * series_count_];
+            uint32_t series_mask = series_mask_of(row);
+            for (size_t series = 0; series < series_count_ && series_mask != 0; ++series, series_mask >>= 1) {
+                bucket_counts[series] += series_mask & 1u;
+            }
+        }
+    });
+
+    row_count_ = count;
+    ++generation_;
+}
+
+void DensityHistogram::AddToRow(size_t series, size_t row) {
+    if (series >= series_count_ || row >= row_count_) {
+        return;
+    }
+    ++counts_[(row / rows_per_bucket_) * series_count_ + series];
+    ++generation_;
+}
+
+void DensityHistogram::ClearSeries(size_t series) {
+    if (series >= series_count_) {
+        return;
+    }
+    for (size_t bucket = 0; bucket < bucket_count_; ++bucket) {
+        counts_[bucket * series_count_ + series] = 0;
+    }
+    ++generation_;
+}
+
+uint32_t DensityHistogram::CountRows(size_t series, size_t row_begin, size_t row_end) const {
+    if (series >= series_count_ || row_begin >= row_end || row_begin >= row_count_) {
+        return 0;
+    }
+
+    size_t first_bucket = row_begin / rows_per_bucket_;
+    size_t end_bucket = std::min(bucket_count_, (row_end + rows_per_bucket_ - 1) / rows_per_bucket_);
+    uint32_t total = 0;
+    for (size_t bucket = first_bucket; bucket < end_bucket; ++bucket) {
+        total += counts_[bucket * series_count_ + series];
+    }
+    return total;
+}
+
+void DensityHistogram::MergeBucketPairs() {
+    size_t merged_count = (bucket_count_ + 1) / 2;
+    for (size_t bucket = 0; bucket < merged_count; ++bucket) {
+        for (size_t series = 0; series < series_count_; ++series) {
+            uint32_t sum = counts_[(2 * bucket) * series_count_ + series];
+            if (2 * bucket + 1 < bucket_count_) {
+                sum += counts_[(2 * bucket + 1) * series_count_ + series];
+            }
+            counts_[bucket * series_count_ + series] = sum;
+        }
+    }
+    bucket_count_ = merged_count;
+    counts_.resize(bucket_count_ * series_count_);
+    rows_per_bucket_ *= 2;
+}
+
+} // namespace ue_log
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Per-bucket counts of a few row categories (e.g. errors and warnings) over a list of rows
+ * that only grows at its end, used to draw density marks next to the log table.
+ * Buckets start one row wide and double in width, merging neighbours, whenever the bucket count
+ * would exceed kMaxBuckets, so memory is bounded and appending a row is O(1) amortized.
+ */
+class DensityHistogram {
+public:
+    // Returns the series mask of a row (bit i set if the row belongs to category i)
+    using SeriesMaskFunction = std::function<uint32_t(size_t row)>;
+
+    static constexpr size_t kMaxBuckets = 4096;
+
+    // Rows appended to an empty histogram at once before the counting is spread over all cores
+    static constexpr size_t kMinParallelRows = 65536;
+
+    /**
+     * @param series_count Number of categories counted per bucket (at most 32)
+     */
+    explicit DensityHistogram(size_t series_count);
+
+    /**
+     * Remove all rows.
+     */
+    void Clear();
+
+    /**
+     * Append one row.
+     * @param series_mask Bit i is set if the row belongs to category i
+     */
+    void Append(uint32_t series_mask);
+
+    /**
+     * Append rows [GetRowCount(), GetRowCount() + count). When the histogram is empty and the batch is large
+     * (e.g. right after a file is loaded) the buckets are counted in parallel.
+     * @param count Number of rows to append
+     * @param series_mask_of Called with the absolute row index; must be thread-safe
+     */
+    void AppendRows(size_t count, const SeriesMaskFunction& series_mask_of);
+
+    /**
+     * Count an existing row in one more category (for categories known only after the row was appended,
+     * such as search hits).
+     * @param series Category index
+     * @param row Row below GetRowCount()
+     */
+    void AddToRow(size_t series, size_t row);
+
+    /**
+     * Zero one category in every bucket.
+     * @param series Category index
+     */
+    void ClearSeries(size_t series);
+
+    /**
+     * Count the rows of a category in [row_begin, row_end), at bucket granularity:
+     * buckets partially inside the range are counted whole.
+     * @param series Category index
+     * @param row_begin First row
+     * @param row_end One past the last row
+     * @return Number of rows in the category
+     */
+    uint32_t CountRows(size_t series, size_t row_begin, size_t row_end) const;
+
+    size_t GetSeriesCount() const { return series_count_; }
+    size_t GetRowCount() const { return row_count_; }
+    size_t GetRowsPerBucket() const { return rows_per_bucket_; }
+    size_t GetBucketCount() const { return bucket_count_; }
+
+    // Bumped by every change, so derived data (e.g. a rendered scrollbar) can tell when it is stale
+    uint64_t GetGeneration() const { return generation_; }
+
+private:
+    void MergeBucketPairs();
+
+    std::vector<uint32_t> counts_;   // bucket * series_count_ + series
+    size_t series_count_;
+    size_t row_count_ = 0;
+    size_t rows_per_bucket_ = 1;
+    size_t bucket_count_ = 0;
+    uint64_t generation_ = 0;
+};
+
+} // namespace ue_log
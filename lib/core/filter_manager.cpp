@@ -1,4 +1,5 @@
 #include "filter_manager.h"
+#include "../common/parallel_for.h"
 #include <algorithm>
 
 namespace ue_log {
@@ -57,13 +58,14 @@ std::vector<LogEntry> FilterManager::ApplyFilters(const std::vector<LogEntry>& e
         return entries; // No filters, return all entries
     }
     
-    std::vector<LogEntry> filtered_entries;
-    filtered_entries.reserve(entries.size());
+    // Conditions are evaluated on all cores; matches come back in input order
+    std::vector<size_t> match_indices = parallel::CollectMatchingIndices(entries.size(),
+        [this, &entries](size_t index) { return ShouldIncludeEntry(entries[index]); });
     
-    for (const auto& entry : entries) {
-        if (ShouldIncludeEntry(entry)) {
-            filtered_entries.push_back(entry);
-        }
+    std::vector<LogEntry> filtered_entries;
+    filtered_entries.reserve(match_indices.size());
+    for (size_t index : match_indices) {
+        filtered_entries.push_back(entries[index]);
     }
     
     return filtered_entries;
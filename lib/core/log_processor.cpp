@@ -1,7 +1,8 @@
 #include "log_processor.h"
+#include "../common/string_search.h"
+#include "../common/regex_matcher.h"
 #include <filesystem>
 #include <algorithm>
-#include <regex>
 
 namespace ue_log {
 
@@ -155,53 +156,34 @@ std::vector<int> LogProcessor::Search(const std::string& query, bool case_sensit
     
     const auto& active_entries = GetActiveEntries();
     
-    try {
-        std::regex search_regex;
-        if (case_sensitive) {
-            search_regex = std::regex(query);
-        } else {
-            search_regex = std::regex(query, std::regex_constants::icase);
-        }
-        
+    auto search_regex = RegexMatcher::Compile(query, !case_sensitive);
+    if (search_regex) {
         for (size_t i = 0; i < active_entries.size(); ++i) {
             const auto& entry = active_entries[i];
             
             // Search in message, logger, and log level
-            bool found = std::regex_search(entry.Get_message(), search_regex) ||
-                        std::regex_search(entry.Get_logger_name(), search_regex);
+            bool found = search_regex->Search(entry.Get_message()) ||
+                        search_regex->Search(entry.Get_logger_name());
             
             // Check log level if it exists
             if (!found && entry.Get_log_level().has_value()) {
-                found = std::regex_search(entry.Get_log_level().value(), search_regex);
+                found = search_regex->Search(entry.Get_log_level().value());
             }
             
             if (found) {
                 results.push_back(static_cast<int>(i));
             }
         }
-    } catch (const std::regex_error&) {
-        // If regex fails, fall back to simple string search
-        std::string search_query = query;
-        if (!case_sensitive) {
-            std::transform(search_query.begin(), search_query.end(), search_query.begin(), ::tolower);
-        }
+    } else {
+        // If the pattern is not a valid regex, fall back to simple string search over the original text
+        string_search::SubstringMatcher matcher(query, case_sensitive);
         
         for (size_t i = 0; i < active_entries.size(); ++i) {
             const auto& entry = active_entries[i];
             
-            std::string message = entry.Get_message();
-            std::string logger = entry.Get_logger_name();
-            std::string log_level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : "";
-            
-            if (!case_sensitive) {
-                std::transform(message.begin(), message.end(), message.begin(), ::tolower);
-                std::transform(logger.begin(), logger.end(), logger.begin(), ::tolower);
-                std::transform(log_level.begin(), log_level.end(), log_level.begin(), ::tolower);
-            }
-            
-            if (message.find(search_query) != std::string::npos ||
-                logger.find(search_query) != std::string::npos ||
-                (!log_level.empty() && log_level.find(search_query) != std::string::npos)) {
+            if (matcher.Matches(entry.Get_message()) ||
+                matcher.Matches(entry.Get_logger_name()) ||
+                (entry.Get_log_level().has_value() && matcher.Matches(entry.Get_log_level().value()))) {
                 results.push_back(static_cast<int>(i));
             }
         }
@@ -0,0 +1,98 @@
+#include "perf_counters.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+
+namespace ue_log {
+
+namespace {
+    // Nearest-rank percentile of sorted samples
+    double Percentile(const std::vector<double>& sorted, double percentile) {
+        size_t rank = static_cast<size_t>(std::ceil(percentile / 100.0 * static_cast<double>(sorted.size())));
+        return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1];
+    }
+}
+
+void PerfCounters::Record(Metric metric, double value) {
+    if (metric >= kMetricCount) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    Window& window = windows_[metric];
+    window.samples[window.total_count % kWindowSize] = value;
+    ++window.total_count;
+}
+
+PerfCounters::Summary PerfCounters::GetSummary(Metric metric) const {
+    Summary summary;
+    if (metric >= kMetricCount) {
+        return summary;
+    }
+
+    std::vector<double> sorted;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const Window& window = windows_[metric];
+        if (window.total_count == 0) {
+            return summary;
+        }
+        summary.total_count = window.total_count;
+        summary.last = window.samples[(window.total_count - 1) % kWindowSize];
+        sorted.assign(window.samples.begin(), window.samples.begin() + std::min(window.total_count, kWindowSize));
+    }
+
+    std::sort(sorted.begin(), sorted.end());
+    summary.p50 = Percentile(sorted, 50.0);
+    summary.p99 = Percentile(sorted, 99.0);
+    summary.max = sorted.back();
+    return summary;
+}
+
+void PerfCounters::Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    windows_ = {};
+}
+
+Result PerfCounters::WriteToFile(const std::string& file_path) const {
+    std::ofstream file(file_path, std::ios::trunc);
+    if (!file.is_open()) {
+        return Result::Error(ErrorCode::FileAccessDenied, "Cannot write performance counters to: " + file_path);
+    }
+
+    file << "metric unit count last p50 p99 max\n";
+    file << std::fixed << std::setprecision(3);
+    for (size_t i = 0; i < kMetricCount; ++i) {
+        Metric metric = static_cast<Metric>(i);
+        Summary summary = GetSummary(metric);
+        file << GetMetricName(metric) << ' ' << GetMetricUnit(metric) << ' ' << summary.total_count << ' '
+             << summary.last << ' ' << summary.p50 << ' ' << summary.p99 << ' ' << summary.max << '\n';
+    }
+
+    if (!file) {
+        return Result::Error(ErrorCode::FileAccessDenied, "Failed writing performance counters to: " + file_path);
+    }
+    return Result::Success();
+}
+
+const char* PerfCounters::GetMetricName(Metric metric) {
+    switch (metric) {
+        case FrameBuild: return "frame_build";
+        case EventHandling: return "event_handling";
+        case FilterApply: return "filter_apply";
+        case SearchScan: return "search_scan";
+        case IngestLatency: return "ingest_latency";
+        case IngestQueueDepth: return "ingest_queue_depth";
+        default: return "unknown";
+    }
+}
+
+const char* PerfCounters::GetMetricUnit(Metric metric) {
+    return metric == IngestQueueDepth ? "lines" : "ms";
+}
+
+double PerfCounters::MillisecondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace ue_log
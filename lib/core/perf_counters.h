@@ -0,0 +1,98 @@
+#pragma once
+
+#include "../common/result.h"
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Rolling samples of the viewer's timing counters (frame build, input handling, filtering, searching,
+ * live-tail ingest), summarized as p50/p99 over the last kWindowSize samples of each metric.
+ * Used by the performance HUD and written to a file for headless runs. Record may be called from any thread.
+ */
+class PerfCounters {
+public:
+    enum Metric : size_t {
+        FrameBuild,       // Building the element tree of one frame (ms)
+        EventHandling,    // Handling one input event (ms)
+        FilterApply,      // Rebuilding the filtered view (ms)
+        SearchScan,       // From starting a search until every entry in the view was scanned (ms)
+        IngestLatency,    // From tailed lines arriving until the frame that shows them (ms)
+        IngestQueueDepth, // Tailed lines waiting for that frame (lines)
+        kMetricCount
+    };
+
+    static constexpr size_t kWindowSize = 256;
+
+    struct Summary {
+        size_t total_count = 0; // Samples recorded since the start, not just those in the window
+        double last = 0.0;
+        double p50 = 0.0;
+        double p99 = 0.0;
+        double max = 0.0;       // Over the window
+    };
+
+    /**
+     * Times a scope and records the elapsed milliseconds when it ends.
+     */
+    class ScopedTimer {
+    public:
+        ScopedTimer(PerfCounters& counters, Metric metric)
+            : counters_(counters), metric_(metric), start_(std::chrono::steady_clock::now()) {}
+        ~ScopedTimer() { counters_.Record(metric_, PerfCounters::MillisecondsSince(start_)); }
+
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    private:
+        PerfCounters& counters_;
+        Metric metric_;
+        std::chrono::steady_clock::time_point start_;
+    };
+
+    /**
+     * Add one sample.
+     * @param metric Metric the sample belongs to
+     * @param value Sample in the metric's unit
+     */
+    void Record(Metric metric, double value);
+
+    /**
+     * Summarize the samples in a metric's window.
+     * @param metric Metric to summarize
+     * @return Summary (all zero without samples)
+     */
+    Summary GetSummary(Metric metric) const;
+
+    /**
+     * Drop every sample.
+     */
+    void Reset();
+
+    /**
+     * Write one line per metric (name, unit, sample count, last, p50, p99, max) to a file, replacing it.
+     * @param file_path Output file
+     * @return Success, or an error if the file cannot be written
+     */
+    Result WriteToFile(const std::string& file_path) const;
+
+    static const char* GetMetricName(Metric metric);
+    static const char* GetMetricUnit(Metric metric);
+    static double MillisecondsSince(std::chrono::steady_clock::time_point start);
+
+private:
+    struct Window {
+        std::array<double, kWindowSize> samples{};
+        size_t total_count = 0;
+    };
+
+    mutable std::mutex mutex_;
+    std::array<Window, kMetricCount> windows_;
+};
+
+} // namespace ue_log
@@ -0,0 +1,96 @@
+#include "redraw_scheduler.h"
+#include <algorithm>
+
+namespace ue_log {
+
+RedrawScheduler::~RedrawScheduler() {
+    Stop();
+}
+
+void RedrawScheduler::SetWakeCallback(WakeCallback callback) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    wake_callback_ = std::move(callback);
+}
+
+void RedrawScheduler::SetMaxFps(int fps) {
+    max_fps_.store(std::max(1, fps), std::memory_order_relaxed);
+}
+
+void RedrawScheduler::MarkDirty(uint32_t regions) {
+    dirty_regions_.fetch_or(regions, std::memory_order_acq_rel);
+}
+
+void RedrawScheduler::RequestRedraw(uint32_t regions) {
+    MarkDirty(regions);
+
+    WakeCallback wake;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (wake_pending_ || stopped_ || !wake_callback_) {
+            return; // The frame already on its way picks up the new flags
+        }
+        wake_pending_ = true;
+
+        auto interval = std::chrono::microseconds(1000000 / max_fps_.load(std::memory_order_relaxed));
+        Clock::time_point due = last_frame_ + interval;
+        if (Clock::now() < due) {
+            // Too soon after the last frame: the timer thread wakes the UI once the interval is up
+            wake_due_ = due;
+            timer_armed_ = true;
+            if (!timer_thread_.joinable()) {
+                timer_thread_ = std::thread([this]() { TimerLoop(); });
+            }
+            timer_cv_.notify_one();
+            return;
+        }
+        wake = wake_callback_;
+    }
+    wake();
+}
+
+uint32_t RedrawScheduler::BeginFrame() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        last_frame_ = Clock::now();
+        wake_pending_ = false;
+        timer_armed_ = false;
+    }
+    return dirty_regions_.exchange(None, std::memory_order_acq_rel);
+}
+
+void RedrawScheduler::Stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+        timer_armed_ = false;
+    }
+    timer_cv_.notify_one();
+    if (timer_thread_.joinable()) {
+        timer_thread_.join();
+    }
+}
+
+void RedrawScheduler::TimerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopped_) {
+        if (!timer_armed_) {
+            timer_cv_.wait(lock);
+            continue;
+        }
+        if (Clock::now() < wake_due_) {
+            timer_cv_.wait_until(lock, wake_due_);
+            continue;
+        }
+
+        // wake_pending_ stays set until the frame starts, so requests in between stay coalesced
+        timer_armed_ = false;
+        WakeCallback wake = wake_callback_;
+        lock.unlock();
+        if (wake) {
+            wake();
+        }
+        lock.lock();
+    }
+}
+
+} // namespace ue_log
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ue_log {
+
+/**
+ * Coalesces redraw requests from background sources (tailing, search progress) into frames.
+ * Requests only set dirty flags for the panes they affect; at most one wake-up of the UI loop
+ * is outstanding at a time, and wake-ups are spaced at least one frame interval apart.
+ * The UI thread takes the accumulated flags at the start of each frame and rebuilds only those panes.
+ * RequestRedraw and MarkDirty may be called from any thread.
+ */
+class RedrawScheduler {
+public:
+    // Panes that can be redrawn independently
+    enum Region : uint32_t {
+        None = 0,
+        Table = 1u << 0,
+        StatusBar = 1u << 1,
+        DetailView = 1u << 2,
+        FilterPanel = 1u << 3,
+        All = Table | StatusBar | DetailView | FilterPanel
+    };
+
+    // Called (on any thread) to make the UI loop draw a frame
+    using WakeCallback = std::function<void()>;
+
+    RedrawScheduler() = default;
+    ~RedrawScheduler();
+
+    RedrawScheduler(const RedrawScheduler&) = delete;
+    RedrawScheduler& operator=(const RedrawScheduler&) = delete;
+
+    /**
+     * Set the function that wakes up the UI loop.
+     * @param callback Wake function, or nullptr to disable wake-ups
+     */
+    void SetWakeCallback(WakeCallback callback);
+
+    /**
+     * Cap the rate of wake-ups; frames caused by input events are not delayed.
+     * @param fps Maximum frames per second (values below 1 are treated as 1)
+     */
+    void SetMaxFps(int fps);
+
+    int GetMaxFps() const { return max_fps_.load(std::memory_order_relaxed); }
+
+    /**
+     * Mark panes dirty and make sure a frame follows, no sooner than one frame interval after the last one.
+     * @param regions Bitwise OR of Region values
+     */
+    void RequestRedraw(uint32_t regions);
+
+    /**
+     * Mark panes dirty without waking the UI loop (for changes made while handling an input event,
+     * which is always followed by a frame).
+     * @param regions Bitwise OR of Region values
+     */
+    void MarkDirty(uint32_t regions);
+
+    /**
+     * Start a frame: take the panes dirtied since the previous frame and cancel any pending wake-up.
+     * @return Bitwise OR of Region values
+     */
+    uint32_t BeginFrame();
+
+    /**
+     * Stop the timer thread; no wake-ups happen afterwards.
+     */
+    void Stop();
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void TimerLoop();
+
+    std::atomic<uint32_t> dirty_regions_{All};
+    std::atomic<int> max_fps_{60};
+
+    std::mutex mutex_;
+    std::condition_variable timer_cv_;
+    std::thread timer_thread_;
+    WakeCallback wake_callback_;      // Guarded by mutex_
+    Clock::time_point last_frame_;    // Guarded by mutex_
+    Clock::time_point wake_due_;      // Guarded by mutex_
+    bool wake_pending_ = false;       // A wake-up was issued or armed and no frame has started since
+    bool timer_armed_ = false;        // The timer thread will wake the UI at wake_due_
+    bool stopped_ = false;
+};
+
+} // namespace ue_log
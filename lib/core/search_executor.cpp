@@ -0,0 +1,115 @@
+#include "search_executor.h"
+#include <algorithm>
+
+namespace ue_log {
+
+void MatchSpanTable::Clear() {
+    spans_.clear();
+    span_begin_.assign(1, 0);
+}
+
+void MatchSpanTable::AddResult(const std::vector<string_search::MatchSpan>& spans) {
+    spans_.insert(spans_.end(), spans.begin(), spans.end());
+    span_begin_.push_back(spans_.size());
+}
+
+void MatchSpanTable::Append(MatchSpanTable& other) {
+    size_t base = spans_.size();
+    spans_.insert(spans_.end(), other.spans_.begin(), other.spans_.end());
+    for (size_t i = 1; i < other.span_begin_.size(); ++i) {
+        span_begin_.push_back(base + other.span_begin_[i]);
+    }
+    other.Clear();
+}
+
+SearchExecutor::~SearchExecutor() {
+    Cancel();
+}
+
+void SearchExecutor::Start(size_t begin, size_t end, MatchFunction matches, ProgressCallback on_progress) {
+    Cancel();
+
+    {
+        std::lock_guard<std::mutex> lock(results_mutex_);
+        pending_results_.clear();
+        pending_spans_.Clear();
+        scanned_end_ = begin;
+    }
+
+    if (begin >= end) {
+        return;
+    }
+
+    auto cancel_token = std::make_shared<std::atomic<bool>>(false);
+    cancel_token_ = cancel_token;
+    running_.store(true, std::memory_order_release);
+
+    worker_ = std::thread([this, begin, end, matches = std::move(matches),
+                           on_progress = std::move(on_progress), cancel_token]() {
+        std::vector<size_t> chunk_results;
+        MatchSpanTable chunk_spans;
+        std::vector<string_search::MatchSpan> entry_spans;
+        for (size_t chunk_begin = begin; chunk_begin < end; chunk_begin += kChunkSize) {
+            if (cancel_token->load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            size_t chunk_end = std::min(chunk_begin + kChunkSize, end);
+            chunk_results.clear();
+            chunk_spans.Clear();
+            for (size_t i = chunk_begin; i < chunk_end; ++i) {
+                entry_spans.clear();
+                if (matches(i, entry_spans)) {
+                    chunk_results.push_back(i);
+                    chunk_spans.AddResult(entry_spans);
+                }
+            }
+
+            // A cancelled chunk is dropped whole, so scanned_end_ always marks a complete prefix
+            if (cancel_token->load(std::memory_order_relaxed)) {
+                break;
+            }
+
+            bool published_matches = !chunk_results.empty();
+            {
+                std::lock_guard<std::mutex> lock(results_mutex_);
+                pending_results_.insert(pending_results_.end(), chunk_results.begin(), chunk_results.end());
+                pending_spans_.Append(chunk_spans);
+                scanned_end_ = chunk_end;
+            }
+            if (published_matches && on_progress) {
+                on_progress();
+            }
+        }
+
+        running_.store(false, std::memory_order_release);
+        if (on_progress && !cancel_token->load(std::memory_order_relaxed)) {
+            on_progress();
+        }
+    });
+}
+
+void SearchExecutor::Cancel() {
+    if (cancel_token_) {
+        cancel_token_->store(true, std::memory_order_relaxed);
+        cancel_token_.reset();
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    running_.store(false, std::memory_order_release);
+}
+
+size_t SearchExecutor::TakeResults(std::vector<size_t>& results, MatchSpanTable* spans) {
+    std::lock_guard<std::mutex> lock(results_mutex_);
+    results.insert(results.end(), pending_results_.begin(), pending_results_.end());
+    pending_results_.clear();
+    if (spans) {
+        spans->Append(pending_spans_);
+    } else {
+        pending_spans_.Clear();
+    }
+    return scanned_end_;
+}
+
+} // namespace ue_log
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "../common/string_search.h"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Match spans of a list of search results, in result order, stored in one flat array:
+ * result i owns spans [GetSpans(i), GetSpans(i) + GetSpanCount(i)).
+ */
+class MatchSpanTable {
+public:
+    /**
+     * Remove all results.
+     */
+    void Clear();
+
+    /**
+     * Add the spans of the next result.
+     * @param spans Matches in the result's entry (may be empty, e.g. when only the logger name matched)
+     */
+    void AddResult(const std::vector<string_search::MatchSpan>& spans);
+
+    /**
+     * Move all results of another table to the end of this one.
+     * @param other Table to take from; left empty
+     */
+    void Append(MatchSpanTable& other);
+
+    size_t GetResultCount() const { return span_begin_.size() - 1; }
+    const string_search::MatchSpan* GetSpans(size_t result) const { return spans_.data() + span_begin_[result]; }
+    size_t GetSpanCount(size_t result) const { return span_begin_[result + 1] - span_begin_[result]; }
+
+private:
+    std::vector<string_search::MatchSpan> spans_;
+    std::vector<size_t> span_begin_{0}; // One more than the result count
+};
+
+/**
+ * Runs a search over an index range on a background thread.
+ * Matches are published chunk by chunk, in increasing index order, so the UI can show and
+ * navigate the first results while the rest of the range is still being scanned.
+ * Each run has its own cancellation token; starting a new run or calling Cancel stops the
+ * previous one and waits for it, after which the searched data may be modified safely.
+ */
+class SearchExecutor {
+public:
+    // Returns true if the entry at the given index matches, appending the spans to highlight; called on the worker thread
+    using MatchFunction = std::function<bool(size_t index, std::vector<string_search::MatchSpan>& spans)>;
+    // Called on the worker thread whenever new matches (or the end of the scan) are published
+    using ProgressCallback = std::function<void()>;
+
+    SearchExecutor() = default;
+    ~SearchExecutor();
+
+    SearchExecutor(const SearchExecutor&) = delete;
+    SearchExecutor& operator=(const SearchExecutor&) = delete;
+
+    /**
+     * Cancel any running search and start scanning [begin, end).
+     * @param begin First index to scan
+     * @param end One past the last index to scan
+     * @param matches Predicate evaluated for every index
+     * @param on_progress Optional notification, e.g. to wake up the UI loop
+     */
+    void Start(size_t begin, size_t end, MatchFunction matches, ProgressCallback on_progress = nullptr);
+
+    /**
+     * Stop the running search (if any) and wait for the worker to exit.
+     * Matches published before cancellation can still be taken with TakeResults.
+     */
+    void Cancel();
+
+    /**
+     * Move the matches published since the last call to the end of a vector.
+     * @param results Receives the new match indices, in increasing order
+     * @param spans Receives the spans of the new matches, in the same order (optional)
+     * @return One past the last index scanned so far; every match below it has been published
+     */
+    size_t TakeResults(std::vector<size_t>& results, MatchSpanTable* spans = nullptr);
+
+    bool IsRunning() const { return running_.load(std::memory_order_acquire); }
+
+    // Indices scanned per published chunk
+    static constexpr size_t kChunkSize = 16384;
+
+private:
+    std::thread worker_;
+    std::shared_ptr<std::atomic<bool>> cancel_token_;
+    std::atomic<bool> running_{false};
+
+    std::mutex results_mutex_;
+    std::vector<size_t> pending_results_;  // Published, not yet taken
+    MatchSpanTable pending_spans_;         // Spans of pending_results_
+    size_t scanned_end_ = 0;               // Guarded by results_mutex_
+};
+
+} // namespace ue_log
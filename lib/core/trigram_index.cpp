@@ -0,0 +1,204 @@
+#include "trigram_index.h"
+#include <algorithm>
+
+namespace ue_log {
+
+namespace {
+
+inline uint32_t FoldAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<uint32_t>(c | 0x20) : c;
+}
+
+inline void AppendVarint(std::vector<uint8_t>& bytes, uint32_t value) {
+    while (value >= 0x80) {
+        bytes.push_back(static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+    bytes.push_back(static_cast<uint8_t>(value));
+}
+
+// Intersect two sorted id lists into the first
+void IntersectInto(std::vector<uint32_t>& ids, const std::vector<uint32_t>& other) {
+    auto out = ids.begin();
+    auto a = ids.begin();
+    auto b = other.begin();
+    while (a != ids.end() && b != other.end()) {
+        if (*a < *b) {
+            ++a;
+        } else if (*b < *a) {
+            ++b;
+        } else {
+            *out++ = *a;
+            ++a;
+            ++b;
+        }
+    }
+    ids.erase(out, ids.end());
+}
+
+} // namespace
+
+std::shared_ptr<const TrigramIndex> TrigramIndex::Build(const std::vector<LogEntry>& entries, size_t count,
+                                                        const std::atomic<bool>* cancel) {
+    constexpr size_t kEntriesPerCancelCheck = 4096;
+
+    auto index = std::make_shared<TrigramIndex>();
+    count = std::min(count, entries.size());
+
+    std::vector<uint32_t> grams;
+    for (size_t i = 0; i < count; ++i) {
+        if (cancel && i % kEntriesPerCancelCheck == 0 && cancel->load(std::memory_order_relaxed)) {
+            return nullptr;
+        }
+        index->AddEntry(static_cast<uint32_t>(i), entries[i], grams);
+    }
+
+    for (auto& gram_postings : index->postings_) {
+        gram_postings.second.bytes.shrink_to_fit();
+    }
+    index->entry_count_ = count;
+    return index;
+}
+
+void TrigramIndex::AppendGrams(std::string_view text, std::vector<uint32_t>& grams) {
+    if (text.size() < kGramLength) {
+        return;
+    }
+    uint32_t gram = (FoldAscii(static_cast<unsigned char>(text[0])) << 8) | FoldAscii(static_cast<unsigned char>(text[1]));
+    for (size_t i = kGramLength - 1; i < text.size(); ++i) {
+        gram = ((gram << 8) | FoldAscii(static_cast<unsigned char>(text[i]))) & 0xFFFFFFu;
+        grams.push_back(gram);
+    }
+}
+
+void TrigramIndex::AddEntry(uint32_t id, const LogEntry& entry, std::vector<uint32_t>& grams) {
+    grams.clear();
+    AppendGrams(entry.Get_message(), grams);
+    AppendGrams(entry.Get_logger_name(), grams);
+    if (entry.Get_log_level().has_value()) {
+        AppendGrams(entry.Get_log_level().value(), grams);
+    }
+    if (entry.Get_timestamp().has_value()) {
+        AppendGrams(entry.Get_timestamp().value(), grams);
+    }
+
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+    for (uint32_t gram : grams) {
+        PostingList& list = postings_[gram];
+        // Ids are added in increasing order; the first delta is the id itself
+        AppendVarint(list.bytes, list.count == 0 ? id : id - list.last_id);
+        list.last_id = id;
+        list.count++;
+    }
+}
+
+void TrigramIndex::Decode(const PostingList& list, std::vector<uint32_t>& ids) {
+    ids.clear();
+    ids.reserve(list.count);
+    uint32_t id = 0;
+    size_t pos = 0;
+    for (uint32_t n = 0; n < list.count; ++n) {
+        uint32_t delta = 0;
+        int shift = 0;
+        uint8_t byte;
+        do {
+            byte = list.bytes[pos++];
+            delta |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            shift += 7;
+        } while (byte & 0x80);
+        id = (n == 0) ? delta : id + delta;
+        ids.push_back(id);
+    }
+}
+
+bool TrigramIndex::FindCandidates(std::string_view needle, std::vector<uint32_t>& candidates) const {
+    candidates.clear();
+    if (needle.size() < kGramLength) {
+        return false;
+    }
+
+    std::vector<uint32_t> grams;
+    AppendGrams(needle, grams);
+    std::sort(grams.begin(), grams.end());
+    grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+
+    std::vector<const PostingList*> lists;
+    for (uint32_t gram : grams) {
+        auto it = postings_.find(gram);
+        if (it == postings_.end()) {
+            return true; // A gram that never occurs: no candidates at all
+        }
+        lists.push_back(&it->second);
+    }
+
+    // Intersect the shortest lists first; once few candidates remain, verifying them is cheaper
+    // than decoding more (long) lists
+    constexpr size_t kMaxListsToIntersect = 4;
+    constexpr size_t kSmallCandidateCount = 64;
+    std::sort(lists.begin(), lists.end(),
+        [](const PostingList* a, const PostingList* b) { return a->count < b->count; });
+
+    Decode(*lists.front(), candidates);
+    std::vector<uint32_t> ids;
+    for (size_t i = 1; i < lists.size() && i < kMaxListsToIntersect; ++i) {
+        if (candidates.size() <= kSmallCandidateCount) {
+            break;
+        }
+        Decode(*lists[i], ids);
+        IntersectInto(candidates, ids);
+    }
+    return true;
+}
+
+size_t TrigramIndex::GetMemoryUsage() const {
+    size_t bytes = postings_.size() * (sizeof(uint32_t) + sizeof(PostingList));
+    for (const auto& gram_postings : postings_) {
+        bytes += gram_postings.second.bytes.capacity();
+    }
+    return bytes;
+}
+
+TrigramIndexBuilder::~TrigramIndexBuilder() {
+    Cancel();
+}
+
+void TrigramIndexBuilder::Start(const std::vector<LogEntry>& entries, std::function<void()> on_ready) {
+    Cancel();
+
+    {
+        std::lock_guard<std::mutex> lock(result_mutex_);
+        result_.reset();
+    }
+    cancel_.store(false, std::memory_order_relaxed);
+    building_.store(true, std::memory_order_release);
+
+    size_t count = entries.size();
+    worker_ = std::thread([this, &entries, count, on_ready = std::move(on_ready)]() {
+        auto index = TrigramIndex::Build(entries, count, &cancel_);
+        if (index) {
+            std::lock_guard<std::mutex> lock(result_mutex_);
+            result_ = std::move(index);
+        }
+        building_.store(false, std::memory_order_release);
+        if (on_ready && !cancel_.load(std::memory_order_relaxed)) {
+            on_ready();
+        }
+    });
+}
+
+void TrigramIndexBuilder::Cancel() {
+    cancel_.store(true, std::memory_order_relaxed);
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    building_.store(false, std::memory_order_release);
+}
+
+std::shared_ptr<const TrigramIndex> TrigramIndexBuilder::TakeIndex() {
+    std::lock_guard<std::mutex> lock(result_mutex_);
+    return std::move(result_);
+}
+
+} // namespace ue_log
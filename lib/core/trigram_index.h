@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../log_parser/log_entry.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Inverted index from 3-byte grams to the entries containing them, used to narrow substring
+ * searches down to a few candidate entries before they are verified.
+ * Grams are taken from each text field (message, logger, level, timestamp) separately and are
+ * ASCII case-folded, so the candidates are a superset of the matches of any case-sensitive or
+ * case-insensitive substring query on any of those fields.
+ * Posting lists are sorted entry ids stored as varint-encoded deltas.
+ */
+class TrigramIndex {
+public:
+    /**
+     * Build an index over entries [0, count).
+     * @param entries Entry store
+     * @param count Number of leading entries to index
+     * @param cancel Optional flag polled during the build
+     * @return The index, or nullptr if the build was cancelled
+     */
+    static std::shared_ptr<const TrigramIndex> Build(const std::vector<LogEntry>& entries, size_t count,
+                                                     const std::atomic<bool>* cancel = nullptr);
+
+    /**
+     * Collect candidate entries for a substring query.
+     * @param needle Query text (any case)
+     * @param candidates Receives sorted entry ids below GetEntryCount() (cleared first)
+     * @return False if the needle is shorter than a gram, in which case nothing is narrowed down
+     */
+    bool FindCandidates(std::string_view needle, std::vector<uint32_t>& candidates) const;
+
+    // Number of leading entries covered; later entries must be checked directly
+    size_t GetEntryCount() const { return entry_count_; }
+    size_t GetGramCount() const { return postings_.size(); }
+    size_t GetMemoryUsage() const;
+
+    static constexpr size_t kGramLength = 3;
+
+private:
+    struct PostingList {
+        std::vector<uint8_t> bytes;   // Varint-encoded deltas between consecutive entry ids
+        uint32_t count = 0;
+        uint32_t last_id = 0;
+    };
+
+    std::unordered_map<uint32_t, PostingList> postings_;
+    size_t entry_count_ = 0;
+
+    void AddEntry(uint32_t id, const LogEntry& entry, std::vector<uint32_t>& grams);
+    static void AppendGrams(std::string_view text, std::vector<uint32_t>& grams);
+    static void Decode(const PostingList& list, std::vector<uint32_t>& ids);
+};
+
+/**
+ * Builds a TrigramIndex on a background thread.
+ * Cancel (or Start) waits for the worker, after which the entry store may be modified again.
+ */
+class TrigramIndexBuilder {
+public:
+    TrigramIndexBuilder() = default;
+    ~TrigramIndexBuilder();
+
+    TrigramIndexBuilder(const TrigramIndexBuilder&) = delete;
+    TrigramIndexBuilder& operator=(const TrigramIndexBuilder&) = delete;
+
+    /**
+     * Cancel any running build and index the current entries in the background.
+     * @param entries Entry store; must not be modified until the build finishes or is cancelled
+     * @param on_ready Optional notification (on the worker thread) when the index is ready
+     */
+    void Start(const std::vector<LogEntry>& entries, std::function<void()> on_ready = nullptr);
+
+    // Stop a running build and wait for the worker to exit
+    void Cancel();
+
+    // The finished index, handed out once; nullptr while building or after it was taken
+    std::shared_ptr<const TrigramIndex> TakeIndex();
+
+    bool IsBuilding() const { return building_.load(std::memory_order_acquire); }
+
+private:
+    std::thread worker_;
+    std::atomic<bool> cancel_{false};
+    std::atomic<bool> building_{false};
+    std::mutex result_mutex_;
+    std::shared_ptr<const TrigramIndex> result_;
+};
+
+} // namespace ue_log
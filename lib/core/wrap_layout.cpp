@@ -0,0 +1,147 @@
+#include "wrap_layout.h"
+#include <algorithm>
+
+namespace ue_log {
+
+namespace {
+    bool IsContinuationByte(char c) {
+        return (static_cast<unsigned char>(c) & 0xC0) == 0x80;
+    }
+
+    // Position after the first `columns` code points of [p, end)
+    size_t AdvanceColumns(const std::string& text, size_t p, size_t end, int columns) {
+        while (p < end && columns > 0) {
+            ++p;
+            while (p < end && IsContinuationByte(text[p])) {
+                ++p;
+            }
+            --columns;
+        }
+        return p;
+    }
+}
+
+WrapLayout::WrapLayout(const std::string& text, int width)
+    : width_(std::max(width, 1)), text_size_(text.size()) {
+    size_t begin = 0;
+    while (begin <= text.size()) {
+        size_t newline = text.find('\n', begin);
+        if (newline == std::string::npos) {
+            // A trailing newline does not start another line, except in an empty text
+            if (begin < text.size() || lines_.empty()) {
+                WrapHardLine(text, begin, text.size());
+            }
+            break;
+        }
+        size_t end = (newline > begin && text[newline - 1] == '\r') ? newline - 1 : newline;
+        WrapHardLine(text, begin, end);
+        begin = newline + 1;
+    }
+}
+
+std::string_view WrapLayout::GetLineText(const std::string& text, size_t index) const {
+    const Line& line = lines_[index];
+    if (line.end > text.size()) {
+        return {};
+    }
+    return std::string_view(text.data() + line.begin, line.end - line.begin);
+}
+
+int WrapLayout::CountColumns(const char* begin, const char* end) {
+    int columns = 0;
+    for (const char* p = begin; p != end; ++p) {
+        if (!IsContinuationByte(*p)) {
+            ++columns;
+        }
+    }
+    return columns;
+}
+
+void WrapLayout::WrapHardLine(const std::string& text, size_t begin, size_t end) {
+    const char* data = text.data();
+    size_t line_begin = begin;
+    size_t line_end = begin;
+    int used = 0;
+    size_t pos = begin;
+
+    while (pos < end) {
+        size_t gap_begin = pos;
+        while (pos < end && text[pos] == ' ') {
+            ++pos;
+        }
+        size_t word_begin = pos;
+        while (pos < end && text[pos] != ' ') {
+            ++pos;
+        }
+        if (word_begin == pos) {
+            break; // Trailing spaces
+        }
+
+        int gap = static_cast<int>(word_begin - gap_begin);
+        int word = CountColumns(data + word_begin, data + pos);
+        if (used + gap + word <= width_) {
+            used += gap + word;
+            line_end = pos;
+            continue;
+        }
+
+        // The word starts a new line; the spaces before it are dropped
+        if (used > 0) {
+            lines_.push_back({line_begin, line_end});
+            line_begin = word_begin;
+            gap = 0;
+        }
+
+        // Split whatever is still too wide for a line of its own
+        int remaining = gap + word;
+        while (remaining > width_) {
+            size_t cut = AdvanceColumns(text, line_begin, pos, width_);
+            lines_.push_back({line_begin, cut});
+            line_begin = cut;
+            remaining -= width_;
+        }
+        used = remaining;
+        line_end = pos;
+    }
+
+    lines_.push_back({line_begin, line_end});
+}
+
+WrapLayoutCache::WrapLayoutCache(size_t max_layouts)
+    : max_layouts_(std::max<size_t>(max_layouts, 2)) {
+}
+
+const WrapLayout& WrapLayoutCache::Get(size_t key, const std::string& text, int width) {
+    ++use_counter_;
+
+    auto it = layouts_.find(key);
+    if (it == layouts_.end()) {
+        if (layouts_.size() >= max_layouts_) {
+            EvictLeastRecentlyUsed();
+        }
+        it = layouts_.try_emplace(key).first;
+        it->second.layout = WrapLayout(text, width);
+    } else if (it->second.layout.GetWidth() != std::max(width, 1) || it->second.layout.GetTextSize() != text.size()) {
+        it->second.layout = WrapLayout(text, width);
+    }
+    it->second.last_used = use_counter_;
+    return it->second.layout;
+}
+
+void WrapLayoutCache::Clear() {
+    layouts_.clear();
+}
+
+void WrapLayoutCache::EvictLeastRecentlyUsed() {
+    // Keep only layouts used within the last max_layouts_ / 2 lookups
+    uint64_t keep_after = use_counter_ - std::min<uint64_t>(use_counter_, max_layouts_ / 2);
+    for (auto it = layouts_.begin(); it != layouts_.end();) {
+        if (it->second.last_used <= keep_after) {
+            it = layouts_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+} // namespace ue_log
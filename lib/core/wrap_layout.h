@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ue_log {
+
+/**
+ * Line breaks of a text wrapped to a fixed width, as byte ranges into the text.
+ * Lines break at '\n' (a trailing '\r' is dropped) and, within a line, greedily between space-separated words;
+ * a word wider than the width is split at code point boundaries. Indentation at the start of a line is kept,
+ * spaces at a wrap point are dropped. Widths are counted one terminal cell per UTF-8 code point.
+ */
+class WrapLayout {
+public:
+    // Byte range [begin, end) of one display line
+    struct Line {
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    WrapLayout() = default;
+
+    /**
+     * @param text Text to wrap; only its size is kept, so the same text must be passed to GetLineText
+     * @param width Display width in terminal cells (values below 1 are treated as 1)
+     */
+    WrapLayout(const std::string& text, int width);
+
+    int GetWidth() const { return width_; }
+    size_t GetTextSize() const { return text_size_; }
+    size_t GetLineCount() const { return lines_.size(); }
+    const Line& GetLine(size_t index) const { return lines_[index]; }
+
+    /**
+     * Get the text of one display line.
+     * @param text The text the layout was built from
+     * @param index Line index below GetLineCount()
+     * @return View into text
+     */
+    std::string_view GetLineText(const std::string& text, size_t index) const;
+
+    /**
+     * Count the terminal cells taken by a UTF-8 string (one per code point; continuation bytes are skipped).
+     */
+    static int CountColumns(const char* begin, const char* end);
+
+private:
+    void WrapHardLine(const std::string& text, size_t begin, size_t end);
+
+    std::vector<Line> lines_;
+    int width_ = 0;
+    size_t text_size_ = 0;
+};
+
+/**
+ * Wrap layouts of many texts, keyed by a caller-chosen id (e.g. a log entry index) and rebuilt only
+ * when the width or the text size for that id changes. Once more than max_layouts are cached,
+ * the least recently used half is dropped.
+ */
+class WrapLayoutCache {
+public:
+    static constexpr size_t kDefaultMaxLayouts = 4096;
+
+    explicit WrapLayoutCache(size_t max_layouts = kDefaultMaxLayouts);
+
+    /**
+     * Get the layout of a text, building it on a miss.
+     * @param key Stable id of the text
+     * @param text The text
+     * @param width Display width in terminal cells
+     * @return Layout, valid until the next call
+     */
+    const WrapLayout& Get(size_t key, const std::string& text, int width);
+
+    /**
+     * Drop every layout; call when the texts behind the keys are replaced.
+     */
+    void Clear();
+
+    size_t GetCachedCount() const { return layouts_.size(); }
+
+private:
+    struct CachedLayout {
+        WrapLayout layout;
+        uint64_t last_used = 0;
+    };
+
+    void EvictLeastRecentlyUsed();
+
+    std::unordered_map<size_t, CachedLayout> layouts_;
+    size_t max_layouts_;
+    uint64_t use_counter_ = 0;
+};
+
+} // namespace ue_log
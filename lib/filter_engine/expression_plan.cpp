@@ -0,0 +1,198 @@
+#include "expression_plan.h"
+#include <algorithm>
+
+namespace ue_log {
+
+    // Intermediate tree produced while folding the expression, before it is laid out flat
+    struct ExpressionPlan::TreeNode {
+        int constant = -1;                          // 0 or 1 when the subtree has a fixed result
+        const FilterCondition* condition = nullptr; // Leaf condition
+        bool is_and = true;
+        std::vector<TreeNode> children;
+
+        static TreeNode Constant(bool value) {
+            TreeNode node;
+            node.constant = value ? 1 : 0;
+            return node;
+        }
+    };
+
+    ExpressionPlan::TreeNode ExpressionPlan::FoldExpression(const FilterExpression& expression) {
+        // Inactive and empty expressions match everything
+        if (!expression.Get_is_active_() || expression.IsEmpty()) {
+            return TreeNode::Constant(true);
+        }
+
+        TreeNode group;
+        group.is_and = expression.Get_operator_() == FilterOperator::And;
+        bool absorbed = false; // A false child of an AND, or a true child of an OR, decides the group
+
+        auto add_child = [&group, &absorbed](TreeNode child) {
+            if (child.constant >= 0) {
+                if ((child.constant == 1) != group.is_and) {
+                    absorbed = true;
+                }
+                return; // Neutral constants are dropped
+            }
+            if (!child.condition && child.is_and == group.is_and) {
+                // Same operator: splice the nested group's children into this one
+                for (TreeNode& grandchild : child.children) {
+                    group.children.push_back(std::move(grandchild));
+                }
+                return;
+            }
+            group.children.push_back(std::move(child));
+        };
+
+        for (const auto& condition : expression.GetConditions()) {
+            if (!condition->Get_is_active_()) {
+                add_child(TreeNode::Constant(true)); // Inactive conditions don't filter anything
+            } else {
+                TreeNode leaf;
+                leaf.condition = condition.get();
+                add_child(std::move(leaf));
+            }
+        }
+        for (const auto& sub_expr : expression.GetSubExpressions()) {
+            add_child(FoldExpression(*sub_expr));
+        }
+
+        if (absorbed) {
+            return TreeNode::Constant(!group.is_and);
+        }
+        if (group.children.empty()) {
+            return TreeNode::Constant(group.is_and);
+        }
+        if (group.children.size() == 1) {
+            return std::move(group.children.front());
+        }
+        return group;
+    }
+
+    ExpressionPlan::ExpressionPlan(const FilterExpression& expression, const std::vector<LogEntry>& entries)
+        : constant_result(true) {
+        TreeNode tree = FoldExpression(expression);
+        if (tree.constant >= 0) {
+            constant_result = tree.constant == 1;
+            return;
+        }
+
+        uint32_t root = Emit(tree);
+
+        // Pass rates are measured on entries spread evenly over the store
+        std::vector<const LogEntry*> sample;
+        size_t step = std::max<size_t>(1, entries.size() / kSelectivitySampleSize);
+        for (size_t i = 0; i < entries.size() && sample.size() < kSelectivitySampleSize; i += step) {
+            sample.push_back(&entries[i]);
+        }
+        MeasureAndOrder(root, sample);
+    }
+
+    uint32_t ExpressionPlan::Emit(const TreeNode& tree) {
+        Node node;
+        node.condition = tree.condition;
+        node.is_and = tree.is_and;
+
+        if (!tree.condition) {
+            std::vector<uint32_t> children;
+            children.reserve(tree.children.size());
+            for (const TreeNode& child : tree.children) {
+                children.push_back(Emit(child));
+            }
+            node.first_child = static_cast<uint32_t>(child_indices.size());
+            node.child_count = static_cast<uint32_t>(children.size());
+            child_indices.insert(child_indices.end(), children.begin(), children.end());
+        }
+
+        nodes.push_back(node);
+        return static_cast<uint32_t>(nodes.size() - 1);
+    }
+
+    void ExpressionPlan::MeasureAndOrder(uint32_t index, const std::vector<const LogEntry*>& sample) {
+        Node& node = nodes[index];
+
+        if (node.condition) {
+            node.cost = GetConditionCost(node.condition->Get_type_());
+        } else {
+            auto first = child_indices.begin() + node.first_child;
+            auto last = first + node.child_count;
+            node.cost = 0;
+            for (auto it = first; it != last; ++it) {
+                MeasureAndOrder(*it, sample);
+                node.cost += nodes[*it].cost;
+            }
+
+            // Expected cost per decisive outcome: an AND child is decisive when it fails, an OR child when it passes.
+            // Cheap integer predicates come first unless a costlier child is much more likely to decide.
+            bool is_and = node.is_and;
+            std::stable_sort(first, last, [this, is_and](uint32_t a, uint32_t b) {
+                auto rank = [this, is_and](uint32_t i) {
+                    double decisive = is_and ? 1.0 - nodes[i].pass_rate : nodes[i].pass_rate;
+                    return nodes[i].cost / std::max(decisive, 0.01);
+                };
+                return rank(a) < rank(b);
+            });
+        }
+
+        if (!sample.empty()) {
+            size_t passed = 0;
+            for (const LogEntry* entry : sample) {
+                if (MatchesNode(index, *entry)) {
+                    ++passed;
+                }
+            }
+            nodes[index].pass_rate = static_cast<double>(passed) / sample.size();
+        }
+    }
+
+    bool ExpressionPlan::MatchesNode(uint32_t index, const LogEntry& entry) const {
+        const Node& node = nodes[index];
+        if (node.condition) {
+            return node.condition->Matches(entry);
+        }
+
+        const uint32_t* child = child_indices.data() + node.first_child;
+        const uint32_t* last = child + node.child_count;
+        if (node.is_and) {
+            for (; child != last; ++child) {
+                if (!MatchesNode(*child, entry)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        for (; child != last; ++child) {
+            if (MatchesNode(*child, entry)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    int ExpressionPlan::GetConditionCost(FilterConditionType type) {
+        switch (type) {
+            case FilterConditionType::FrameAfter:
+            case FilterConditionType::FrameBefore:
+            case FilterConditionType::FrameEquals:
+            case FilterConditionType::LineAfter:
+            case FilterConditionType::LineBefore:
+                return 1; // Integer compare
+            case FilterConditionType::MessageEquals:
+            case FilterConditionType::LoggerEquals:
+            case FilterConditionType::LogLevelEquals:
+            case FilterConditionType::TimestampAfter:
+            case FilterConditionType::TimestampBefore:
+            case FilterConditionType::TimestampEquals:
+                return 2; // Short string compare
+            case FilterConditionType::MessageContains:
+            case FilterConditionType::LoggerContains:
+                return 3; // Substring search
+            case FilterConditionType::AnyFieldContains:
+                return 6; // Substring search over every field
+            case FilterConditionType::MessageRegex:
+                return 10;
+        }
+        return 10;
+    }
+
+} // namespace ue_log
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "../../macros.h"
+#include "filter_expression.h"
+#include "../log_parser/log_entry.h"
+#include <cstdint>
+#include <vector>
+
+namespace ue_log {
+
+    // Flattened evaluation form of a FilterExpression tree, compiled once per filter pass.
+    // Inactive and empty parts are folded away, nested groups with the same operator are merged,
+    // and the children of every group are ordered by cost and by the pass rate measured on a
+    // sample of the entries, so AND groups reject and OR groups accept as early as possible.
+    // The plan points into the expression, which must outlive it and stay unmodified.
+    class ExpressionPlan {
+        CK_GENERATED_BODY(ExpressionPlan);
+
+    public:
+        struct Node {
+            const FilterCondition* condition = nullptr; // Set for leaves
+            bool is_and = true;                          // Operator of a group
+            uint32_t first_child = 0;                    // Range into child_indices for groups
+            uint32_t child_count = 0;
+            int cost = 0;                                // Relative evaluation cost (groups: sum of children)
+            double pass_rate = 0.5;                      // Fraction of the sampled entries that matched
+        };
+
+    private:
+        std::vector<Node> nodes;               // Root last; empty when the result is constant
+        std::vector<uint32_t> child_indices;   // Children of each group, contiguous and in evaluation order
+        bool constant_result;
+
+    public:
+        ExpressionPlan() : constant_result(true) {}
+        ExpressionPlan(const FilterExpression& expression, const std::vector<LogEntry>& entries);
+
+        // Properties using macros
+        CK_PROPERTY_GET(nodes);
+
+        // Same result as FilterExpression::Matches
+        bool Matches(const LogEntry& entry) const {
+            return nodes.empty() ? constant_result : MatchesNode(static_cast<uint32_t>(nodes.size() - 1), entry);
+        }
+
+        bool IsConstant() const { return nodes.empty(); }
+
+        // Relative evaluation cost of a condition type
+        static int GetConditionCost(FilterConditionType type);
+
+        // Maximum number of entries (spread over the store) used to measure pass rates
+        static constexpr size_t kSelectivitySampleSize = 1024;
+
+    private:
+        struct TreeNode;
+
+        static TreeNode FoldExpression(const FilterExpression& expression);
+        bool MatchesNode(uint32_t index, const LogEntry& entry) const;
+        uint32_t Emit(const TreeNode& tree);
+        void MeasureAndOrder(uint32_t index, const std::vector<const LogEntry*>& sample);
+    };
+
+} // namespace ue_log
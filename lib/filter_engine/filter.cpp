@@ -158,6 +158,10 @@ namespace ue_log {
         match_count++;
     }
     
+    void Filter::AddMatchCount(size_t count) {
+        match_count += count;
+    }
+    
     void Filter::ResetMatchCount() {
         match_count = 0;
         // Reset sub-filter counts too
@@ -168,6 +172,17 @@ namespace ue_log {
         }
     }
     
+    void Filter::PrepareForConcurrentUse() const {
+        if (type == FilterType::TextRegex) {
+            CompileRegex();
+        }
+        for (const auto& sub_filter : sub_filters) {
+            if (sub_filter) {
+                sub_filter->PrepareForConcurrentUse();
+            }
+        }
+    }
+    
     bool Filter::IsValid() const {
         if (name.empty() || criteria.empty()) {
             return false;
@@ -234,12 +249,8 @@ namespace ue_log {
     }
     
     bool Filter::MatchesTextRegex(const LogEntry& entry) const {
-        try {
-            const std::regex& regex = GetCompiledRegex();
-            return std::regex_search(entry.Get_message(), regex);
-        } catch (const std::exception&) {
-            return false;
-        }
+        const RegexMatcher* regex = GetCompiledRegex();
+        return regex && regex->Search(entry.Get_message());
     }
     
     bool Filter::MatchesLoggerName(const LogEntry& entry) const {
@@ -292,34 +303,23 @@ namespace ue_log {
         }
     }
     
-    const std::regex& Filter::GetCompiledRegex() const {
-        if (!compiled_regex.has_value() && !regex_compilation_attempted) {
+    const RegexMatcher* Filter::GetCompiledRegex() const {
+        if (!compiled_regex && !regex_compilation_attempted) {
             CompileRegex();
         }
         
-        if (compiled_regex.has_value()) {
-            return compiled_regex.value();
-        }
-        
-        // Return a default regex that matches nothing if compilation failed
-        static const std::regex empty_regex("(?!)"); // Negative lookahead that never matches
-        return empty_regex;
+        // nullptr if compilation failed (matches nothing)
+        return compiled_regex.get();
     }
     
     bool Filter::CompileRegex() const {
         if (regex_compilation_attempted) {
-            return compiled_regex.has_value();
+            return compiled_regex != nullptr;
         }
         
         regex_compilation_attempted = true;
-        
-        try {
-            compiled_regex = std::regex(criteria, std::regex_constants::icase);
-            return true;
-        } catch (const std::regex_error&) {
-            compiled_regex.reset();
-            return false;
-        }
+        compiled_regex = RegexMatcher::Compile(criteria, true);
+        return compiled_regex != nullptr;
     }
     
     // Serialization methods
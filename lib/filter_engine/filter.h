@@ -2,11 +2,10 @@
 
 #include "../../macros.h"
 #include "../log_parser/log_entry.h"
+#include "../common/regex_matcher.h"
 #include <string>
 #include <vector>
 #include <memory>
-#include <regex>
-#include <optional>
 
 namespace ue_log {
     
@@ -46,7 +45,7 @@ namespace ue_log {
         size_t match_count;
         
         // Compiled regex for performance (when using TextRegex)
-        mutable std::optional<std::regex> compiled_regex;
+        mutable std::unique_ptr<RegexMatcher> compiled_regex;
         mutable bool regex_compilation_attempted;
         
     public:
@@ -112,8 +111,13 @@ namespace ue_log {
         // Filtering functionality
         bool Matches(const LogEntry& entry) const;
         void IncrementMatchCount();
+        void AddMatchCount(size_t count);
         void ResetMatchCount();
         
+        // Compile lazily-built matching state (regexes) for this filter and its sub-filters,
+        // so that Matches can afterwards be called from several threads at once
+        void PrepareForConcurrentUse() const;
+        
         // Validation
         bool IsValid() const;
         std::string GetValidationError() const;
@@ -141,7 +145,7 @@ namespace ue_log {
         bool MatchesFrameRange(const LogEntry& entry) const;
         
         // Helper methods
-        const std::regex& GetCompiledRegex() const;
+        const RegexMatcher* GetCompiledRegex() const;
         bool CompileRegex() const;
         bool MatchesInternal(const LogEntry& entry) const;
     };
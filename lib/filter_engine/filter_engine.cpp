@@ -1,5 +1,7 @@
 #include "filter_engine.h"
+#include "../common/parallel_for.h"
 #include <algorithm>
+#include <numeric>
 #include <sstream>
 #include <iomanip>
 #include <fstream>
@@ -28,6 +30,7 @@ namespace ue_log {
         }
         
         primary_filters.push_back(std::move(filter));
+        InvalidatePlan();
         return Result::Success();
     }
     
@@ -42,7 +45,9 @@ namespace ue_log {
                 "Filter '" + filter_name + "' not found");
         }
         
+        match_bitmaps.erase(it->get());
         primary_filters.erase(it);
+        InvalidatePlan();
         return Result::Success();
     }
     
@@ -71,6 +76,8 @@ namespace ue_log {
     
     void FilterEngine::ClearAllFilters() {
         primary_filters.clear();
+        InvalidatePlan();
+        ResetMatchBitmaps();
         ClearRegexCache();
         ResetAllStatistics();
     }
@@ -82,72 +89,112 @@ namespace ue_log {
     std::vector<LogEntry> FilterEngine::ApplyFilters(const std::vector<LogEntry>& entries) {
         std::vector<LogEntry> filtered_entries;
         
+        // Filters may have been edited in place since the last call, so always start from a fresh plan
+        InvalidatePlan();
+        auto plan = GetCompiledPlan();
+        
         // If no active filters, return all entries
-        if (GetTotalActiveFilters() == 0) {
+        if (plan->IsEmpty()) {
             return entries;
         }
         
-        for (const LogEntry& entry : entries) {
-            total_entries_processed++;
-            
-            if (PassesFilters(entry)) {
-                filtered_entries.push_back(entry);
-                total_matches_found++;
-                
-                // Update match counts for matching filters
-                std::vector<const Filter*> matching_filters = GetMatchingFilters(entry);
-                UpdateMatchCounts(entry, matching_filters);
+        // Evaluate chunks on all cores; each worker keeps its own per-filter match counts
+        // (indexed like the plan), which are summed once at the end instead of contending on shared counters
+        const size_t filter_count = plan->Get_compiled_filters().size();
+        std::vector<std::vector<size_t>> worker_match_counts(parallel::GetWorkerCount(),
+                                                             std::vector<size_t>(filter_count, 0));
+        const size_t chunk_count = (entries.size() + parallel::kDefaultChunkSize - 1) / parallel::kDefaultChunkSize;
+        std::vector<std::vector<size_t>> chunk_matches(chunk_count);
+        
+        parallel::ForEachChunk(entries.size(), parallel::kDefaultChunkSize,
+            [&](size_t worker, size_t chunk, size_t begin, size_t end) {
+                std::vector<size_t>& match_counts = worker_match_counts[worker];
+                for (size_t i = begin; i < end; ++i) {
+                    if (plan->Passes(entries[i])) {
+                        chunk_matches[chunk].push_back(i);
+                        
+                        // Update match counts for matching filters
+                        plan->CountMatches(entries[i], match_counts);
+                    }
+                }
+            });
+        
+        // Concatenate in chunk order so the output keeps the input order
+        for (const auto& matches : chunk_matches) {
+            for (size_t index : matches) {
+                filtered_entries.push_back(entries[index]);
             }
         }
+        total_entries_processed += entries.size();
+        total_matches_found += filtered_entries.size();
+        
+        const auto& compiled_filters = plan->Get_compiled_filters();
+        for (size_t i = 0; i < compiled_filters.size(); ++i) {
+            size_t match_count = 0;
+            for (const auto& match_counts : worker_match_counts) {
+                match_count += match_counts[i];
+            }
+            const_cast<Filter*>(compiled_filters[i].source)->AddMatchCount(match_count);
+        }
         
         return filtered_entries;
     }
     
     bool FilterEngine::PassesFilters(const LogEntry& entry) {
-        // If no active filters, entry passes
-        if (GetTotalActiveFilters() == 0) {
-            return true;
+        return GetCompiledPlan()->Passes(entry);
+    }
+    
+    std::shared_ptr<const FilterPlan> FilterEngine::GetCompiledPlan() {
+        if (compiled_plan) {
+            return compiled_plan;
         }
         
-        bool has_include_filters = false;
-        bool has_exclude_filters = false;
-        bool passes_include = false;
-        bool passes_exclude = true; // Start with true, exclude filters will set to false
-        
-        // First pass: check what types of filters we have and apply them
+        std::vector<CompiledFilter> compiled_filters;
         for (const auto& filter : primary_filters) {
             if (!filter || filter->GetFilterState() == FilterState::DISABLED) {
                 continue;
             }
-            
-            if (filter->GetFilterState() == FilterState::INCLUDE) {
-                has_include_filters = true;
-                if (filter->ShouldInclude(entry)) {
-                    passes_include = true;
-                }
-            } else if (filter->GetFilterState() == FilterState::EXCLUDE) {
-                has_exclude_filters = true;
-                if (filter->ShouldExclude(entry)) {
-                    passes_exclude = false; // Entry is excluded
-                }
-            }
+            compiled_filters.push_back(CompileFilter(*filter));
         }
         
-        // Apply logic:
-        // - If we have include filters, entry must pass at least one
-        // - If we have exclude filters, entry must not be excluded by any
-        // - If we have both, entry must pass include AND not be excluded
-        
-        if (has_include_filters && has_exclude_filters) {
-            return passes_include && passes_exclude;
-        } else if (has_include_filters) {
-            return passes_include;
-        } else if (has_exclude_filters) {
-            return passes_exclude;
+        compiled_plan = std::make_shared<const FilterPlan>(std::move(compiled_filters));
+        return compiled_plan;
+    }
+    
+    void FilterEngine::InvalidatePlan() {
+        compiled_plan.reset();
+    }
+    
+    std::vector<size_t> FilterEngine::CollectMatchAllIndices(const std::vector<LogEntry>& entries,
+                                                             const LogCategoryIndex* categories,
+                                                             const EntryRangeIndex* ranges) {
+        auto plan = GetCompiledPlan();
+        std::vector<size_t> match_indices;
+        
+        if (plan->IsEmpty()) {
+            match_indices.resize(entries.size());
+            std::iota(match_indices.begin(), match_indices.end(), size_t{0});
+            return match_indices;
+        }
+        
+        UpdateMatchBitmaps(*plan, entries, categories, ranges);
+        
+        MatchBitmap result(entries.size(), true);
+        for (const CompiledFilter& filter : plan->Get_compiled_filters()) {
+            const MatchBitmap& bitmap = match_bitmaps[filter.source].bitmap;
+            if (filter.state == FilterState::EXCLUDE) {
+                result.AndNotWith(bitmap);
+            } else {
+                result.AndWith(bitmap);
+            }
         }
         
-        // No active filters (shouldn't reach here due to check above)
-        return true;
+        result.AppendSetIndices(match_indices);
+        return match_indices;
+    }
+    
+    void FilterEngine::ResetMatchBitmaps() {
+        match_bitmaps.clear();
     }
     
     std::vector<const Filter*> FilterEngine::GetMatchingFilters(const LogEntry& entry) {
@@ -215,23 +262,23 @@ namespace ue_log {
         return active_filters;
     }
     
-    const std::regex& FilterEngine::GetCachedRegex(const std::string& pattern) {
+    const RegexMatcher* FilterEngine::GetCachedRegex(const std::string& pattern) {
         auto it = compiled_regex_cache.find(pattern);
         if (it != compiled_regex_cache.end()) {
-            return it->second;
+            return it->second.get();
         }
         
         // Compile and cache the regex
         if (CompileAndCacheRegex(pattern)) {
-            return compiled_regex_cache[pattern];
+            return compiled_regex_cache[pattern].get();
         }
         
-        // Return a default regex that matches nothing if compilation failed
-        static const std::regex empty_regex("(?!)"); // Negative lookahead that never matches
-        return empty_regex;
+        return nullptr;
     }
     
     void FilterEngine::ClearRegexCache() {
+        // Compiled plans point into the cache
+        InvalidatePlan();
         compiled_regex_cache.clear();
     }
     
@@ -308,6 +355,7 @@ namespace ue_log {
                 filter->Request_is_active(active);
             }
         }
+        InvalidatePlan();
     }
     
     // Filter persistence methods
@@ -457,14 +505,183 @@ namespace ue_log {
     
     // Private helper methods
     
+    void FilterEngine::UpdateMatchBitmaps(const FilterPlan& plan, const std::vector<LogEntry>& entries,
+                                          const LogCategoryIndex* categories, const EntryRangeIndex* ranges) {
+        struct PendingFilter {
+            const CompiledFilter* filter;
+            MatchBitmap* bitmap;
+            size_t begin; // First entry that still needs evaluating
+        };
+        
+        const size_t entry_count = entries.size();
+        std::vector<PendingFilter> pending;
+        for (const CompiledFilter& filter : plan.Get_compiled_filters()) {
+            FilterMatchCache& cache = match_bitmaps[filter.source];
+            
+            // Sub-filter trees can change underneath their parent, so they are always re-evaluated
+            bool stale = filter.has_sub_filters || cache.type != filter.type || cache.criteria != filter.needle ||
+                         cache.bitmap.Get_size() > entry_count;
+            size_t begin = cache.bitmap.Get_size();
+            if (stale) {
+                cache.type = filter.type;
+                cache.criteria = filter.needle;
+                cache.bitmap = MatchBitmap(entry_count);
+                begin = 0;
+            } else if (begin == entry_count) {
+                continue; // Up to date
+            } else {
+                cache.bitmap.Resize(entry_count); // Entries were appended
+            }
+            pending.push_back({&filter, &cache.bitmap, begin});
+        }
+        
+        // Logger and level filters set their bits straight from the category posting lists
+        if (categories && categories->Get_entry_count() == entry_count) {
+            pending.erase(std::remove_if(pending.begin(), pending.end(), [categories](const PendingFilter& item) {
+                const CompiledFilter& filter = *item.filter;
+                if (filter.has_sub_filters || (filter.type != FilterType::LoggerName && filter.type != FilterType::LogLevel)) {
+                    return false;
+                }
+                const std::vector<uint32_t>& posting = (filter.type == FilterType::LoggerName)
+                    ? categories->GetLoggerEntries(filter.needle)
+                    : categories->GetLevelEntries(filter.needle);
+                for (auto it = std::lower_bound(posting.begin(), posting.end(), item.begin); it != posting.end(); ++it) {
+                    item.bitmap->Set(*it);
+                }
+                return true;
+            }), pending.end());
+        }
+        
+        // Frame range filters are only evaluated inside the blocks whose frame summary overlaps the range
+        if (ranges && ranges->Get_entry_count() == entry_count) {
+            std::vector<EntryInterval> intervals;
+            pending.erase(std::remove_if(pending.begin(), pending.end(), [ranges, &entries, &intervals](const PendingFilter& item) {
+                const CompiledFilter& filter = *item.filter;
+                if (filter.has_sub_filters || filter.type != FilterType::FrameRange) {
+                    return false;
+                }
+                if (filter.is_valid) {
+                    ranges->FindFrameIntervals(filter.frame_min, filter.frame_max, intervals);
+                    for (const EntryInterval& interval : intervals) {
+                        for (size_t i = std::max(interval.begin, item.begin); i < interval.end; ++i) {
+                            if (FilterPlan::MatchesFilter(filter, entries[i])) {
+                                item.bitmap->Set(i);
+                            }
+                        }
+                    }
+                }
+                return true;
+            }), pending.end());
+        }
+        
+        if (pending.empty()) {
+            return;
+        }
+        
+        // Several new literal filters are evaluated together in one automaton pass
+        std::vector<const PendingFilter*> literal_filters;
+        std::vector<const PendingFilter*> other_filters;
+        size_t literal_begin = entry_count;
+        for (const PendingFilter& item : pending) {
+            if (item.filter->type == FilterType::TextContains && item.filter->is_valid && !item.filter->has_sub_filters) {
+                literal_filters.push_back(&item);
+                literal_begin = std::min(literal_begin, item.begin);
+            } else {
+                other_filters.push_back(&item);
+            }
+        }
+        if (literal_filters.size() < FilterPlan::kMinFoldedLiteralFilters) {
+            other_filters.insert(other_filters.end(), literal_filters.begin(), literal_filters.end());
+            literal_filters.clear();
+        }
+        
+        MultiPatternMatcher literal_matcher;
+        if (!literal_filters.empty()) {
+            std::vector<std::string> patterns;
+            for (const PendingFilter* item : literal_filters) {
+                patterns.push_back(item->filter->needle);
+            }
+            literal_matcher = MultiPatternMatcher(patterns, true);
+        }
+        
+        // Chunks start on word boundaries, so no two workers ever write the same bitmap word
+        size_t base = entry_count;
+        for (const PendingFilter& item : pending) {
+            base = std::min(base, item.begin);
+        }
+        base -= base % MatchBitmap::kBitsPerWord;
+        
+        parallel::ForEachChunk(entry_count - base, parallel::kDefaultChunkSize,
+            [&](size_t, size_t, size_t chunk_begin, size_t chunk_end) {
+                chunk_begin += base;
+                chunk_end += base;
+                
+                if (!literal_filters.empty()) {
+                    thread_local std::vector<size_t> matched_ids;
+                    for (size_t i = std::max(chunk_begin, literal_begin); i < chunk_end; ++i) {
+                        literal_matcher.FindMatches(entries[i].Get_message(), matched_ids);
+                        for (size_t id : matched_ids) {
+                            literal_filters[id]->bitmap->Set(i);
+                        }
+                    }
+                }
+                
+                for (const PendingFilter* item : other_filters) {
+                    for (size_t i = std::max(chunk_begin, item->begin); i < chunk_end; ++i) {
+                        if (FilterPlan::MatchesFilter(*item->filter, entries[i])) {
+                            item->bitmap->Set(i);
+                        }
+                    }
+                }
+            });
+    }
+    
     bool FilterEngine::CompileAndCacheRegex(const std::string& pattern) {
-        try {
-            std::regex compiled_regex(pattern, std::regex_constants::icase);
-            compiled_regex_cache[pattern] = std::move(compiled_regex);
-            return true;
-        } catch (const std::regex_error&) {
+        auto compiled_regex = RegexMatcher::Compile(pattern, true);
+        if (!compiled_regex) {
             return false;
         }
+        compiled_regex_cache[pattern] = std::move(compiled_regex);
+        return true;
+    }
+    
+    CompiledFilter FilterEngine::CompileFilter(const Filter& filter) {
+        CompiledFilter compiled;
+        compiled.source = &filter;
+        compiled.type = filter.Get_type();
+        compiled.state = filter.GetFilterState();
+        compiled.needle = filter.Get_criteria();
+        compiled.has_sub_filters = filter.GetSubFilterCount() > 0;
+        compiled.cost = FilterPlan::GetFilterCost(compiled.type);
+        
+        if (compiled.has_sub_filters) {
+            // Sub-filter trees are evaluated through the source filter, possibly from several threads
+            filter.PrepareForConcurrentUse();
+        }
+        
+        if (compiled.type == FilterType::TextRegex) {
+            // Shared across filters with the same pattern
+            compiled.regex = GetCachedRegex(compiled.needle);
+            if (!compiled.regex) {
+                compiled.is_valid = false;
+            }
+        } else if (compiled.type == FilterType::FrameRange) {
+            // Parse criteria as "min-max" or single number
+            try {
+                size_t dash_pos = compiled.needle.find('-');
+                if (dash_pos != std::string::npos) {
+                    compiled.frame_min = std::stoi(compiled.needle.substr(0, dash_pos));
+                    compiled.frame_max = std::stoi(compiled.needle.substr(dash_pos + 1));
+                } else {
+                    compiled.frame_min = std::stoi(compiled.needle);
+                    compiled.frame_max = compiled.frame_min;
+                }
+            } catch (const std::exception&) {
+                compiled.is_valid = false;
+            }
+        }
+        
+        return compiled;
     }
     
     void FilterEngine::UpdateMatchCounts(const LogEntry& entry, const std::vector<const Filter*>& matching_filters) {
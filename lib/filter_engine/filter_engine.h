@@ -2,21 +2,34 @@
 
 #include "../../macros.h"
 #include "../common/result.h"
+#include "../common/regex_matcher.h"
 #include "filter.h"
+#include "filter_plan.h"
+#include "match_bitmap.h"
+#include "../log_parser/log_category_index.h"
+#include "../log_parser/entry_range_index.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <unordered_map>
-#include <regex>
 
 namespace ue_log {
     
+    // Raw (state-independent) matches of one filter over the entry store, kept across filter edits
+    struct FilterMatchCache {
+        FilterType type = FilterType::TextContains;
+        std::string criteria;
+        MatchBitmap bitmap;
+    };
+    
     class FilterEngine {
         CK_GENERATED_BODY(FilterEngine);
         
     private:
         std::vector<std::unique_ptr<Filter>> primary_filters;
-        std::unordered_map<std::string, std::regex> compiled_regex_cache;
+        std::unordered_map<std::string, std::unique_ptr<RegexMatcher>> compiled_regex_cache;
+        std::shared_ptr<const FilterPlan> compiled_plan;
+        std::unordered_map<const Filter*, FilterMatchCache> match_bitmaps;
         size_t total_entries_processed;
         size_t total_matches_found;
         
@@ -44,14 +57,31 @@ namespace ue_log {
         bool PassesFilters(const LogEntry& entry);
         std::vector<const Filter*> GetMatchingFilters(const LogEntry& entry);
         
+        // Compiled evaluation plan (rebuilt lazily after the filter set changes)
+        std::shared_ptr<const FilterPlan> GetCompiledPlan();
+        void InvalidatePlan();
+        
+        // Indices of the entries that match every include filter and no exclude filter.
+        // Per-filter match bitmaps are cached, so toggling, cycling, adding or removing a filter
+        // only evaluates filters that are new or edited (and entries appended since the last call);
+        // everything else is combined with word-level AND/ANDNOT.
+        // With a category index over the same entries, logger and level filters only visit the entries they match;
+        // with a range index, frame range filters only visit the blocks whose frames overlap the range.
+        std::vector<size_t> CollectMatchAllIndices(const std::vector<LogEntry>& entries,
+                                                   const LogCategoryIndex* categories = nullptr,
+                                                   const EntryRangeIndex* ranges = nullptr);
+        
+        // Drop cached match bitmaps; call whenever the entry store is replaced (not just appended to)
+        void ResetMatchBitmaps();
+        
         // Statistics and management
         void UpdateFilterStatistics(const std::vector<LogEntry>& entries);
         void ResetAllStatistics();
         size_t GetTotalActiveFilters() const;
         std::vector<Filter*> GetActiveFilters();
         
-        // Regex caching (shared across all filters)
-        const std::regex& GetCachedRegex(const std::string& pattern);
+        // Regex caching (shared across all filters); returns nullptr for invalid patterns
+        const RegexMatcher* GetCachedRegex(const std::string& pattern);
         void ClearRegexCache();
         size_t GetRegexCacheSize() const;
         
@@ -72,6 +102,9 @@ namespace ue_log {
     private:
         // Internal helper methods
         bool CompileAndCacheRegex(const std::string& pattern);
+        CompiledFilter CompileFilter(const Filter& filter);
+        void UpdateMatchBitmaps(const FilterPlan& plan, const std::vector<LogEntry>& entries,
+                                const LogCategoryIndex* categories, const EntryRangeIndex* ranges);
         void UpdateMatchCounts(const LogEntry& entry, const std::vector<const Filter*>& matching_filters);
         size_t FindMatchingBrace(const std::string& json_data, size_t start_pos) const;
     };
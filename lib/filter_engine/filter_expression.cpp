@@ -1,6 +1,7 @@
 #include "filter_expression.h"
 #include <algorithm>
-#include <regex>
+#include <climits>
+#include <iterator>
 #include <sstream>
 
 namespace ue_log {
@@ -14,11 +15,7 @@ bool FilterCondition::Matches(const LogEntry& entry) const {
     
     switch (type_) {
         case FilterConditionType::MessageContains: {
-            std::string message = entry.Get_message();
-            std::string value = value_;
-            std::transform(message.begin(), message.end(), message.begin(), ::tolower);
-            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-            return message.find(value) != std::string::npos;
+            return value_matcher_.Matches(entry.Get_message());
         }
         
         case FilterConditionType::MessageEquals: {
@@ -26,12 +23,8 @@ bool FilterCondition::Matches(const LogEntry& entry) const {
         }
         
         case FilterConditionType::MessageRegex: {
-            try {
-                std::regex pattern(value_, std::regex_constants::icase);
-                return std::regex_search(entry.Get_message(), pattern);
-            } catch (const std::regex_error&) {
-                return false; // Invalid regex doesn't match anything
-            }
+            // Invalid regex doesn't match anything
+            return compiled_regex_ && compiled_regex_->Search(entry.Get_message());
         }
         
         case FilterConditionType::LoggerEquals: {
@@ -39,11 +32,7 @@ bool FilterCondition::Matches(const LogEntry& entry) const {
         }
         
         case FilterConditionType::LoggerContains: {
-            std::string logger = entry.Get_logger_name();
-            std::string value = value_;
-            std::transform(logger.begin(), logger.end(), logger.begin(), ::tolower);
-            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-            return logger.find(value) != std::string::npos;
+            return value_matcher_.Matches(entry.Get_logger_name());
         }
         
         case FilterConditionType::LogLevelEquals: {
@@ -75,72 +64,122 @@ bool FilterCondition::Matches(const LogEntry& entry) const {
         }
         
         case FilterConditionType::FrameAfter: {
-            if (!entry.Get_frame_number().has_value()) {
-                return false;
-            }
-            try {
-                int frame_value = std::stoi(value_);
-                return entry.Get_frame_number().value() >= frame_value;
-            } catch (const std::exception&) {
+            if (!entry.Get_frame_number().has_value() || !has_numeric_value_) {
                 return false;
             }
+            return entry.Get_frame_number().value() >= numeric_value_;
         }
         
         case FilterConditionType::FrameBefore: {
-            if (!entry.Get_frame_number().has_value()) {
+            if (!entry.Get_frame_number().has_value() || !has_numeric_value_) {
                 return false;
             }
-            try {
-                int frame_value = std::stoi(value_);
-                return entry.Get_frame_number().value() <= frame_value;
-            } catch (const std::exception&) {
+            return entry.Get_frame_number().value() <= numeric_value_;
+        }
+        
+        case FilterConditionType::FrameEquals: {
+            if (!entry.Get_frame_number().has_value() || !has_numeric_value_) {
                 return false;
             }
+            return entry.Get_frame_number().value() == numeric_value_;
         }
         
-        case FilterConditionType::FrameEquals: {
-            if (!entry.Get_frame_number().has_value()) {
+        case FilterConditionType::LineAfter: {
+            return has_numeric_value_ && static_cast<int>(entry.Get_line_number()) >= numeric_value_;
+        }
+        
+        case FilterConditionType::LineBefore: {
+            return has_numeric_value_ && static_cast<int>(entry.Get_line_number()) < numeric_value_;
+        }
+        
+        case FilterConditionType::AnyFieldContains: {
+            // Each field is searched in place rather than concatenating them into a lowered copy
+            if (value_matcher_.Matches(entry.Get_message()) ||
+                value_matcher_.Matches(entry.Get_logger_name())) {
+                return true;
+            }
+            if (entry.Get_log_level().has_value() && value_matcher_.Matches(entry.Get_log_level().value())) {
+                return true;
+            }
+            return entry.Get_timestamp().has_value() && value_matcher_.Matches(entry.Get_timestamp().value());
+        }
+        
+        default:
+            return false;
+    }
+}
+
+bool FilterCondition::CollectCandidates(const CandidateIndexes& indexes, std::vector<uint32_t>& candidates,
+                                        size_t& indexed_count) const {
+    if (!is_active_) {
+        return false;
+    }
+    
+    switch (type_) {
+        case FilterConditionType::MessageContains:
+        case FilterConditionType::LoggerContains:
+        case FilterConditionType::AnyFieldContains:
+            // The trigram index folds ASCII case like value_matcher_, so its candidates cover every match
+            if (!indexes.trigrams || !indexes.trigrams->FindCandidates(value_, candidates)) {
                 return false;
             }
-            try {
-                int frame_value = std::stoi(value_);
-                return entry.Get_frame_number().value() == frame_value;
-            } catch (const std::exception&) {
+            indexed_count = indexes.trigrams->GetEntryCount();
+            return true;
+        
+        case FilterConditionType::LoggerEquals:
+            if (!indexes.categories) {
                 return false;
             }
-        }
+            candidates = indexes.categories->GetLoggerEntries(value_);
+            indexed_count = indexes.categories->Get_entry_count();
+            return true;
         
-        case FilterConditionType::LineAfter: {
-            try {
-                int line_value = std::stoi(value_);
-                return static_cast<int>(entry.Get_line_number()) >= line_value;
-            } catch (const std::exception&) {
+        case FilterConditionType::LogLevelEquals:
+            if (!indexes.categories) {
                 return false;
             }
-        }
+            candidates = indexes.categories->GetLevelEntries(value_);
+            indexed_count = indexes.categories->Get_entry_count();
+            return true;
         
+        default:
+            return false;
+    }
+}
+
+bool FilterCondition::CollectIntervals(const EntryRangeIndex& ranges, const std::vector<LogEntry>& entries,
+                                       std::vector<EntryInterval>& intervals) const {
+    intervals.clear();
+    if (!is_active_) {
+        return false;
+    }
+    
+    switch (type_) {
+        case FilterConditionType::LineAfter:
         case FilterConditionType::LineBefore: {
-            try {
-                int line_value = std::stoi(value_);
-                return static_cast<int>(entry.Get_line_number()) < line_value;
-            } catch (const std::exception&) {
-                return false;
+            if (!has_numeric_value_) {
+                return true; // Never matches
+            }
+            // Same comparison as Matches, which compares line numbers as int
+            EntryInterval interval = (type_ == FilterConditionType::LineAfter)
+                ? ranges.FindLineInterval(entries, numeric_value_, INT_MAX)
+                : ranges.FindLineInterval(entries, LLONG_MIN, static_cast<long long>(numeric_value_) - 1);
+            if (interval.begin < interval.end) {
+                intervals.push_back(interval);
             }
+            return true;
         }
         
-        case FilterConditionType::AnyFieldContains: {
-            std::string search_text = entry.Get_message() + " " + entry.Get_logger_name();
-            if (entry.Get_log_level().has_value()) {
-                search_text += " " + entry.Get_log_level().value();
-            }
-            if (entry.Get_timestamp().has_value()) {
-                search_text += " " + entry.Get_timestamp().value();
+        case FilterConditionType::FrameAfter:
+        case FilterConditionType::FrameBefore:
+        case FilterConditionType::FrameEquals: {
+            if (!has_numeric_value_) {
+                return true; // Never matches
             }
-            
-            std::string value = value_;
-            std::transform(search_text.begin(), search_text.end(), search_text.begin(), ::tolower);
-            std::transform(value.begin(), value.end(), value.begin(), ::tolower);
-            return search_text.find(value) != std::string::npos;
+            int min_frame = (type_ == FilterConditionType::FrameBefore) ? INT_MIN : numeric_value_;
+            int max_frame = (type_ == FilterConditionType::FrameAfter) ? INT_MAX : numeric_value_;
+            ranges.FindFrameIntervals(min_frame, max_frame, intervals);
+            return true;
         }
         
         default:
@@ -148,6 +187,26 @@ bool FilterCondition::Matches(const LogEntry& entry) const {
     }
 }
 
+void FilterCondition::Compile() {
+    // Needles for the case-insensitive conditions are lowered once here instead of per entry
+    value_matcher_ = string_search::SubstringMatcher(value_, false);
+    
+    // Regex conditions are compiled once; an invalid pattern never matches
+    compiled_regex_.reset();
+    if (type_ == FilterConditionType::MessageRegex) {
+        compiled_regex_ = RegexMatcher::Compile(value_, true);
+    }
+    
+    // Frame and line operands are parsed once; an unparsable operand never matches
+    numeric_value_ = 0;
+    has_numeric_value_ = false;
+    try {
+        numeric_value_ = std::stoi(value_);
+        has_numeric_value_ = true;
+    } catch (const std::exception&) {
+    }
+}
+
 std::string FilterCondition::ToString() const {
     std::string field = GetFieldName();
     std::string op = GetOperatorName();
@@ -272,6 +331,109 @@ bool FilterExpression::Matches(const LogEntry& entry) const {
     return result;
 }
 
+bool FilterExpression::CollectCandidates(const CandidateIndexes& indexes, std::vector<uint32_t>& candidates,
+                                         size_t& indexed_count) const {
+    candidates.clear();
+    if (!is_active_ || IsEmpty()) {
+        return false;
+    }
+    
+    bool is_and = (operator_ == FilterOperator::And);
+    bool narrowed = false;
+    std::vector<uint32_t> child_candidates;
+    std::vector<uint32_t> combined;
+    size_t child_indexed_count = 0;
+    
+    auto merge = [&](bool child_narrowed) {
+        if (!child_narrowed) {
+            return is_and; // AND ignores unconstrained children; OR cannot be narrowed down at all
+        }
+        // Children may cover different prefixes of the entries; the result covers the shortest one
+        if (!narrowed) {
+            candidates.swap(child_candidates);
+            indexed_count = child_indexed_count;
+            narrowed = true;
+            return true;
+        }
+        indexed_count = std::min(indexed_count, child_indexed_count);
+        combined.clear();
+        if (is_and) {
+            std::set_intersection(candidates.begin(), candidates.end(),
+                                  child_candidates.begin(), child_candidates.end(), std::back_inserter(combined));
+        } else {
+            std::set_union(candidates.begin(), candidates.end(),
+                           child_candidates.begin(), child_candidates.end(), std::back_inserter(combined));
+        }
+        candidates.swap(combined);
+        return true;
+    };
+    
+    for (const auto& condition : conditions_) {
+        if (!merge(condition->CollectCandidates(indexes, child_candidates, child_indexed_count))) {
+            candidates.clear();
+            return false;
+        }
+    }
+    for (const auto& sub_expr : sub_expressions_) {
+        if (!merge(sub_expr->CollectCandidates(indexes, child_candidates, child_indexed_count))) {
+            candidates.clear();
+            return false;
+        }
+    }
+    
+    // Entries past the covered prefix are evaluated directly, so they must not appear twice
+    if (narrowed) {
+        candidates.erase(std::lower_bound(candidates.begin(), candidates.end(), indexed_count), candidates.end());
+    }
+    return narrowed;
+}
+
+bool FilterExpression::CollectIntervals(const EntryRangeIndex& ranges, const std::vector<LogEntry>& entries,
+                                        std::vector<EntryInterval>& intervals) const {
+    intervals.clear();
+    if (!is_active_ || IsEmpty()) {
+        return false;
+    }
+    
+    bool is_and = (operator_ == FilterOperator::And);
+    bool constrained = false;
+    std::vector<EntryInterval> child_intervals;
+    std::vector<EntryInterval> combined;
+    
+    auto merge = [&](bool child_constrained) {
+        if (!child_constrained) {
+            return is_and; // AND ignores unconstrained children; OR cannot be constrained at all
+        }
+        if (!constrained) {
+            intervals.swap(child_intervals);
+            constrained = true;
+            return true;
+        }
+        if (is_and) {
+            EntryRangeIndex::Intersect(intervals, child_intervals, combined);
+        } else {
+            EntryRangeIndex::Unite(intervals, child_intervals, combined);
+        }
+        intervals.swap(combined);
+        return true;
+    };
+    
+    for (const auto& condition : conditions_) {
+        if (!merge(condition->CollectIntervals(ranges, entries, child_intervals))) {
+            intervals.clear();
+            return false;
+        }
+    }
+    for (const auto& sub_expr : sub_expressions_) {
+        if (!merge(sub_expr->CollectIntervals(ranges, entries, child_intervals))) {
+            intervals.clear();
+            return false;
+        }
+    }
+    
+    return constrained;
+}
+
 std::string FilterExpression::ToString() const {
     if (IsEmpty()) {
         return "No filters";
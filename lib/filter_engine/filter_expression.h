@@ -3,6 +3,12 @@
 #include "../../macros.h"
 #include "filter.h"
 #include "../log_parser/log_entry.h"
+#include "../common/string_search.h"
+#include "../common/regex_matcher.h"
+#include "../log_parser/log_category_index.h"
+#include "../log_parser/entry_range_index.h"
+#include "../core/trigram_index.h"
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
@@ -32,6 +38,15 @@ enum class FilterConditionType {
     AnyFieldContains
 };
 
+/**
+ * Entry indexes that can narrow an expression down to candidate entries before it is evaluated.
+ * Either may be null.
+ */
+struct CandidateIndexes {
+    const TrigramIndex* trigrams = nullptr;
+    const LogCategoryIndex* categories = nullptr;
+};
+
 /**
  * Represents a single filter condition (leaf node in the expression tree)
  */
@@ -43,22 +58,55 @@ private:
     std::string value_;
     bool is_active_;
     
+    // Evaluation state compiled from type_ and value_ (rebuilt whenever either changes)
+    string_search::SubstringMatcher value_matcher_; // Case-insensitive needle for the *Contains conditions
+    std::shared_ptr<const RegexMatcher> compiled_regex_; // Shared so conditions stay copyable
+    int numeric_value_ = 0;           // value_ parsed for the frame and line conditions
+    bool has_numeric_value_ = false;  // False when value_ is not a number (those conditions never match)
+    
 public:
     FilterCondition(FilterConditionType type, const std::string& value)
-        : type_(type), value_(value), is_active_(true) {}
+        : type_(type), value_(value), is_active_(true) {
+        Compile();
+    }
     
     // Properties
-    CK_PROPERTY(type_);
-    CK_PROPERTY(value_);
+    CK_PROPERTY_GET(type_);
+    CK_PROPERTY_GET(value_);
     CK_PROPERTY(is_active_);
     
+    // Setters recompile the evaluation state
+    auto Request_type_(const FilterConditionType& value) -> FilterCondition& {
+        type_ = value;
+        Compile();
+        return *this;
+    }
+    auto Request_value_(const std::string& value) -> FilterCondition& {
+        value_ = value;
+        Compile();
+        return *this;
+    }
+    
     // Evaluation
     bool Matches(const LogEntry& entry) const;
     
+    // Superset of the entries below indexed_count this condition can match (sorted ids).
+    // Returns false when the condition cannot be narrowed down by the indexes.
+    bool CollectCandidates(const CandidateIndexes& indexes, std::vector<uint32_t>& candidates,
+                           size_t& indexed_count) const;
+    
+    // Runs of entries that can satisfy a line or frame condition (a superset of the matches).
+    // Returns false for other conditions, which are not range predicates.
+    bool CollectIntervals(const EntryRangeIndex& ranges, const std::vector<LogEntry>& entries,
+                          std::vector<EntryInterval>& intervals) const;
+    
     // Display
     std::string ToString() const;
     std::string GetFieldName() const;
     std::string GetOperatorName() const;
+    
+private:
+    void Compile();
 };
 
 /**
@@ -94,6 +142,19 @@ public:
     // Evaluation
     bool Matches(const LogEntry& entry) const;
     
+    // Superset of the entries below indexed_count this expression can match (sorted ids): AND intersects
+    // the narrowed-down children, OR unites them when every child can be narrowed down.
+    // Entries from indexed_count on must be evaluated directly.
+    // Returns false when the expression cannot be narrowed down by the indexes.
+    bool CollectCandidates(const CandidateIndexes& indexes, std::vector<uint32_t>& candidates,
+                           size_t& indexed_count) const;
+    
+    // Runs of entries this expression can match, from its line and frame conditions: AND intersects
+    // the range-constrained children, OR unites them when every child is range-constrained.
+    // Returns false when the expression has no range constraint.
+    bool CollectIntervals(const EntryRangeIndex& ranges, const std::vector<LogEntry>& entries,
+                          std::vector<EntryInterval>& intervals) const;
+    
     // Display
     std::string ToString() const;
     bool IsEmpty() const;
@@ -0,0 +1,189 @@
+#include "filter_plan.h"
+#include <algorithm>
+
+namespace ue_log {
+
+    FilterPlan::FilterPlan(std::vector<CompiledFilter> filters)
+        : compiled_filters(std::move(filters)), include_begin(0) {
+        // Excludes first (any match rejects), then includes; cheap predicates first within each group,
+        // and among equal cost the ones that matched most often last time, since they decide earliest
+        std::stable_sort(compiled_filters.begin(), compiled_filters.end(),
+            [](const CompiledFilter& a, const CompiledFilter& b) {
+                bool a_exclude = a.state == FilterState::EXCLUDE;
+                bool b_exclude = b.state == FilterState::EXCLUDE;
+                if (a_exclude != b_exclude) {
+                    return a_exclude;
+                }
+                if (a.cost != b.cost) {
+                    return a.cost < b.cost;
+                }
+                size_t a_matches = a.source ? a.source->Get_match_count() : 0;
+                size_t b_matches = b.source ? b.source->Get_match_count() : 0;
+                return a_matches > b_matches;
+            });
+
+        include_begin = static_cast<size_t>(std::count_if(compiled_filters.begin(), compiled_filters.end(),
+            [](const CompiledFilter& filter) { return filter.state == FilterState::EXCLUDE; }));
+
+        FoldLiteralFilters(0, include_begin, exclude_literals);
+        FoldLiteralFilters(include_begin, compiled_filters.size(), include_literals);
+    }
+
+    void FilterPlan::FoldLiteralFilters(size_t begin, size_t end, LiteralFilterGroup& group) {
+        std::vector<size_t> candidates;
+        for (size_t i = begin; i < end; ++i) {
+            const CompiledFilter& filter = compiled_filters[i];
+            if (filter.type == FilterType::TextContains && filter.is_valid && !filter.has_sub_filters) {
+                candidates.push_back(i);
+            }
+        }
+        if (candidates.size() < kMinFoldedLiteralFilters) {
+            return;
+        }
+
+        std::vector<std::string> patterns;
+        patterns.reserve(candidates.size());
+        for (size_t index : candidates) {
+            compiled_filters[index].is_folded = true;
+            patterns.push_back(compiled_filters[index].needle);
+        }
+        group.matcher = MultiPatternMatcher(patterns, true);
+        group.filter_indices = std::move(candidates);
+        group.first_index = group.filter_indices.front();
+    }
+
+    // Folded filters are skipped individually; their automaton runs once, at the position of the first of them
+
+    bool FilterPlan::Passes(const LogEntry& entry) const {
+        for (size_t i = 0; i < include_begin; ++i) {
+            if (compiled_filters[i].is_folded) {
+                if (i == exclude_literals.first_index && exclude_literals.matcher.ContainsAny(entry.Get_message())) {
+                    return false;
+                }
+                continue;
+            }
+            if (MatchesFilter(compiled_filters[i], entry)) {
+                return false; // Entry is excluded
+            }
+        }
+
+        if (!HasIncludeFilters()) {
+            return true;
+        }
+
+        for (size_t i = include_begin; i < compiled_filters.size(); ++i) {
+            if (compiled_filters[i].is_folded) {
+                if (i == include_literals.first_index && include_literals.matcher.ContainsAny(entry.Get_message())) {
+                    return true;
+                }
+                continue;
+            }
+            if (MatchesFilter(compiled_filters[i], entry)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool FilterPlan::MatchesAll(const LogEntry& entry) const {
+        for (size_t i = 0; i < include_begin; ++i) {
+            if (compiled_filters[i].is_folded) {
+                if (i == exclude_literals.first_index && exclude_literals.matcher.ContainsAny(entry.Get_message())) {
+                    return false;
+                }
+                continue;
+            }
+            if (MatchesFilter(compiled_filters[i], entry)) {
+                return false;
+            }
+        }
+
+        for (size_t i = include_begin; i < compiled_filters.size(); ++i) {
+            if (compiled_filters[i].is_folded) {
+                if (i == include_literals.first_index && !include_literals.matcher.ContainsAll(entry.Get_message())) {
+                    return false;
+                }
+                continue;
+            }
+            if (!MatchesFilter(compiled_filters[i], entry)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void FilterPlan::CountMatches(const LogEntry& entry, std::vector<size_t>& match_counts) const {
+        thread_local std::vector<size_t> matched_ids;
+
+        for (const LiteralFilterGroup* group : {&exclude_literals, &include_literals}) {
+            if (group->IsEmpty()) {
+                continue;
+            }
+            group->matcher.FindMatches(entry.Get_message(), matched_ids);
+            for (size_t id : matched_ids) {
+                match_counts[group->filter_indices[id]]++;
+            }
+        }
+
+        for (size_t i = 0; i < compiled_filters.size(); ++i) {
+            if (!compiled_filters[i].is_folded && MatchesFilter(compiled_filters[i], entry)) {
+                match_counts[i]++;
+            }
+        }
+    }
+
+    bool FilterPlan::MatchesFilter(const CompiledFilter& filter, const LogEntry& entry) {
+        if (!filter.is_valid) {
+            return false;
+        }
+
+        if (filter.has_sub_filters) {
+            // Sub-filter trees keep their own combination logic
+            return filter.state == FilterState::EXCLUDE ?
+                   filter.source->ShouldExclude(entry) :
+                   filter.source->ShouldInclude(entry);
+        }
+
+        switch (filter.type) {
+            case FilterType::TextContains:
+                return entry.Get_message().find(filter.needle) != std::string::npos;
+            case FilterType::TextExact:
+                return entry.Get_message() == filter.needle;
+            case FilterType::TextRegex:
+                return filter.regex && filter.regex->Search(entry.Get_message());
+            case FilterType::LoggerName:
+                return entry.Get_logger_name() == filter.needle;
+            case FilterType::LogLevel:
+                return entry.HasLogLevel() && entry.Get_log_level().value() == filter.needle;
+            case FilterType::TimeRange:
+                return entry.HasTimestamp() &&
+                       entry.Get_timestamp().value().find(filter.needle) != std::string::npos;
+            case FilterType::FrameRange: {
+                if (!entry.HasFrameNumber()) {
+                    return false;
+                }
+                int frame = entry.Get_frame_number().value();
+                return frame >= filter.frame_min && frame <= filter.frame_max;
+            }
+        }
+        return false;
+    }
+
+    int FilterPlan::GetFilterCost(FilterType type) {
+        switch (type) {
+            case FilterType::FrameRange:
+                return 1; // Integer compare
+            case FilterType::LogLevel:
+            case FilterType::LoggerName:
+            case FilterType::TextExact:
+                return 2; // Short string compare
+            case FilterType::TimeRange:
+            case FilterType::TextContains:
+                return 3; // Substring search
+            case FilterType::TextRegex:
+                return 10;
+        }
+        return 10;
+    }
+
+} // namespace ue_log
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../../macros.h"
+#include "filter.h"
+#include "../common/regex_matcher.h"
+#include "../common/multi_pattern_matcher.h"
+#include "../log_parser/log_entry.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ue_log {
+
+    // Pre-compiled form of a single primary filter, built once when the filter set changes
+    struct CompiledFilter {
+        const Filter* source = nullptr;      // Filter this entry was compiled from (for statistics)
+        FilterType type = FilterType::TextContains;
+        FilterState state = FilterState::INCLUDE;
+        std::string needle;                  // Criteria copied at compile time
+        const RegexMatcher* regex = nullptr; // Owned by the FilterEngine regex cache
+        int frame_min = 0;                   // Pre-parsed FrameRange bounds
+        int frame_max = 0;
+        bool is_valid = true;                // False when the criteria could not be parsed (never matches)
+        bool has_sub_filters = false;        // Sub-filter trees are delegated to the source filter
+        int cost = 0;                        // Relative evaluation cost used for ordering
+        bool is_folded = false;              // Evaluated through the plan's literal automaton instead of one by one
+    };
+
+    // TextContains filters of one state (exclude or include) folded into a single automaton over the message
+    struct LiteralFilterGroup {
+        MultiPatternMatcher matcher;
+        std::vector<size_t> filter_indices;  // Pattern id -> index into the plan's compiled filters
+        size_t first_index = SIZE_MAX;       // Position in evaluation order where the automaton runs
+
+        bool IsEmpty() const { return filter_indices.empty(); }
+    };
+
+    // Immutable evaluation plan for the active primary filters.
+    // Exclude filters come first, then include filters; each group is ordered by
+    // cost and, for equal cost, by how often the filter matched in the last run.
+    // When a group has several TextContains filters they are matched together in one pass.
+    class FilterPlan {
+        CK_GENERATED_BODY(FilterPlan);
+
+    private:
+        std::vector<CompiledFilter> compiled_filters;
+        size_t include_begin;
+        LiteralFilterGroup exclude_literals;
+        LiteralFilterGroup include_literals;
+
+    public:
+        FilterPlan() : include_begin(0) {}
+        explicit FilterPlan(std::vector<CompiledFilter> filters);
+
+        // Properties using macros
+        CK_PROPERTY_GET(compiled_filters);
+        CK_PROPERTY_GET(include_begin);
+
+        bool IsEmpty() const { return compiled_filters.empty(); }
+        bool HasIncludeFilters() const { return include_begin < compiled_filters.size(); }
+
+        // FilterEngine semantics: matches at least one include filter (if any) and no exclude filter
+        bool Passes(const LogEntry& entry) const;
+
+        // MainWindow semantics: matches every include filter and no exclude filter
+        bool MatchesAll(const LogEntry& entry) const;
+
+        // Add one to match_counts[i] for every compiled filter i that matches the entry
+        void CountMatches(const LogEntry& entry, std::vector<size_t>& match_counts) const;
+
+        // Raw (state-independent) match of a single compiled filter
+        static bool MatchesFilter(const CompiledFilter& filter, const LogEntry& entry);
+
+        // Relative evaluation cost of a filter type
+        static int GetFilterCost(FilterType type);
+
+        // Minimum number of TextContains filters in a group before they are folded into an automaton
+        static constexpr size_t kMinFoldedLiteralFilters = 4;
+
+    private:
+        void FoldLiteralFilters(size_t begin, size_t end, LiteralFilterGroup& group);
+    };
+
+} // namespace ue_log
@@ -0,0 +1,92 @@
+#include "match_bitmap.h"
+#include <algorithm>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace ue_log {
+
+    namespace {
+
+        inline int CountTrailingZeros64(uint64_t value) {
+#if defined(_MSC_VER)
+            unsigned long index;
+            _BitScanForward64(&index, value);
+            return static_cast<int>(index);
+#else
+            return __builtin_ctzll(value);
+#endif
+        }
+
+        inline size_t PopCount64(uint64_t value) {
+#if defined(_MSC_VER)
+            return static_cast<size_t>(__popcnt64(value));
+#else
+            return static_cast<size_t>(__builtin_popcountll(value));
+#endif
+        }
+
+    } // namespace
+
+    MatchBitmap::MatchBitmap(size_t bit_count, bool value)
+        : words((bit_count + kBitsPerWord - 1) / kBitsPerWord, value ? ~uint64_t{0} : 0), size(bit_count) {
+        ClearTrailingBits();
+    }
+
+    void MatchBitmap::Resize(size_t bit_count) {
+        words.resize((bit_count + kBitsPerWord - 1) / kBitsPerWord, 0);
+        size = bit_count;
+        ClearTrailingBits();
+    }
+
+    void MatchBitmap::AndWith(const MatchBitmap& other) {
+        const size_t count = std::min(words.size(), other.words.size());
+        for (size_t i = 0; i < count; ++i) {
+            words[i] &= other.words[i];
+        }
+        std::fill(words.begin() + static_cast<std::ptrdiff_t>(count), words.end(), 0);
+    }
+
+    void MatchBitmap::OrWith(const MatchBitmap& other) {
+        const size_t count = std::min(words.size(), other.words.size());
+        for (size_t i = 0; i < count; ++i) {
+            words[i] |= other.words[i];
+        }
+        ClearTrailingBits();
+    }
+
+    void MatchBitmap::AndNotWith(const MatchBitmap& other) {
+        const size_t count = std::min(words.size(), other.words.size());
+        for (size_t i = 0; i < count; ++i) {
+            words[i] &= ~other.words[i];
+        }
+    }
+
+    size_t MatchBitmap::CountSetBits() const {
+        size_t count = 0;
+        for (uint64_t word : words) {
+            count += PopCount64(word);
+        }
+        return count;
+    }
+
+    void MatchBitmap::AppendSetIndices(std::vector<size_t>& indices) const {
+        indices.reserve(indices.size() + CountSetBits());
+        for (size_t w = 0; w < words.size(); ++w) {
+            uint64_t word = words[w];
+            while (word != 0) {
+                indices.push_back(w * kBitsPerWord + static_cast<size_t>(CountTrailingZeros64(word)));
+                word &= word - 1;
+            }
+        }
+    }
+
+    void MatchBitmap::ClearTrailingBits() {
+        const size_t used_bits = size % kBitsPerWord;
+        if (used_bits != 0 && !words.empty()) {
+            words.back() &= (uint64_t{1} << used_bits) - 1;
+        }
+    }
+
+} // namespace ue_log
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "../../macros.h"
+#include <cstdint>
+#include <vector>
+
+namespace ue_log {
+
+    // One bit per log entry, used to cache which entries a filter matches and to combine
+    // filters with word-level AND/OR/ANDNOT instead of re-evaluating them per entry.
+    // Bits past size are always zero.
+    class MatchBitmap {
+        CK_GENERATED_BODY(MatchBitmap);
+
+    private:
+        std::vector<uint64_t> words;
+        size_t size;
+
+    public:
+        static constexpr size_t kBitsPerWord = 64;
+
+        MatchBitmap() : size(0) {}
+        explicit MatchBitmap(size_t bit_count, bool value = false);
+
+        // Properties using macros
+        CK_PROPERTY_GET(words);
+        CK_PROPERTY_GET(size);
+
+        // Grow or shrink; new bits are cleared
+        void Resize(size_t bit_count);
+
+        void Set(size_t index) { words[index / kBitsPerWord] |= uint64_t{1} << (index % kBitsPerWord); }
+        bool Test(size_t index) const { return (words[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1u; }
+
+        // In-place combination with a bitmap of the same size
+        void AndWith(const MatchBitmap& other);
+        void OrWith(const MatchBitmap& other);
+        void AndNotWith(const MatchBitmap& other);
+
+        size_t CountSetBits() const;
+
+        // Append the indices of all set bits, in increasing order
+        void AppendSetIndices(std::vector<size_t>& indices) const;
+
+    private:
+        void ClearTrailingBits();
+    };
+
+} // namespace ue_log
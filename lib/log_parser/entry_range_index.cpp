@@ -0,0 +1,115 @@
+#include "entry_range_index.h"
+#include <algorithm>
+
+namespace ue_log {
+
+    void EntryRangeIndex::AddEntry(const LogEntry& entry) {
+        if (entry_count % kBlockSize == 0) {
+            block_frame_min.push_back(INT_MAX);
+            block_frame_max.push_back(INT_MIN);
+        }
+        if (entry.HasFrameNumber()) {
+            int frame = entry.Get_frame_number().value();
+            block_frame_min.back() = std::min(block_frame_min.back(), frame);
+            block_frame_max.back() = std::max(block_frame_max.back(), frame);
+        }
+
+        if (entry_count > 0 && entry.Get_line_number() < last_line_number) {
+            lines_ascending = false;
+        }
+        last_line_number = entry.Get_line_number();
+        ++entry_count;
+    }
+
+    void EntryRangeIndex::Rebuild(const std::vector<LogEntry>& entries) {
+        Clear();
+        block_frame_min.reserve(entries.size() / kBlockSize + 1);
+        block_frame_max.reserve(entries.size() / kBlockSize + 1);
+        for (const LogEntry& entry : entries) {
+            AddEntry(entry);
+        }
+    }
+
+    void EntryRangeIndex::Clear() {
+        block_frame_min.clear();
+        block_frame_max.clear();
+        last_line_number = 0;
+        lines_ascending = true;
+        entry_count = 0;
+    }
+
+    EntryInterval EntryRangeIndex::FindLineInterval(const std::vector<LogEntry>& entries,
+                                                    long long min_line, long long max_line) const {
+        size_t count = std::min(entry_count, entries.size());
+        if (!lines_ascending) {
+            return {0, count};
+        }
+        if (min_line > max_line) {
+            return {0, 0};
+        }
+
+        auto begin = entries.begin();
+        auto end = entries.begin() + count;
+        auto first = std::lower_bound(begin, end, min_line, [](const LogEntry& entry, long long line) {
+            return static_cast<long long>(entry.Get_line_number()) < line;
+        });
+        auto last = std::upper_bound(first, end, max_line, [](long long line, const LogEntry& entry) {
+            return line < static_cast<long long>(entry.Get_line_number());
+        });
+        return {static_cast<size_t>(first - begin), static_cast<size_t>(last - begin)};
+    }
+
+    void EntryRangeIndex::FindFrameIntervals(int min_frame, int max_frame, std::vector<EntryInterval>& intervals) const {
+        intervals.clear();
+        for (size_t block = 0; block < block_frame_min.size(); ++block) {
+            if (block_frame_max[block] < min_frame || block_frame_min[block] > max_frame) {
+                continue;
+            }
+            size_t begin = block * kBlockSize;
+            size_t end = std::min(begin + kBlockSize, entry_count);
+            if (!intervals.empty() && intervals.back().end == begin) {
+                intervals.back().end = end;
+            } else {
+                intervals.push_back({begin, end});
+            }
+        }
+    }
+
+    void EntryRangeIndex::Intersect(const std::vector<EntryInterval>& a, const std::vector<EntryInterval>& b,
+                                    std::vector<EntryInterval>& result) {
+        result.clear();
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.size() && j < b.size()) {
+            size_t begin = std::max(a[i].begin, b[j].begin);
+            size_t end = std::min(a[i].end, b[j].end);
+            if (begin < end) {
+                result.push_back({begin, end});
+            }
+            if (a[i].end < b[j].end) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+    }
+
+    void EntryRangeIndex::Unite(const std::vector<EntryInterval>& a, const std::vector<EntryInterval>& b,
+                                std::vector<EntryInterval>& result) {
+        result.clear();
+        size_t i = 0;
+        size_t j = 0;
+        while (i < a.size() || j < b.size()) {
+            const EntryInterval& next = (j == b.size() || (i < a.size() && a[i].begin <= b[j].begin)) ? a[i++] : b[j++];
+            if (next.begin >= next.end) {
+                continue;
+            }
+            if (!result.empty() && next.begin <= result.back().end) {
+                result.back().end = std::max(result.back().end, next.end);
+            } else {
+                result.push_back(next);
+            }
+        }
+    }
+
+} // namespace ue_log
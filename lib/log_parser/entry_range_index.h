@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../macros.h"
+#include "log_entry.h"
+#include <climits>
+#include <cstdint>
+#include <vector>
+
+namespace ue_log {
+
+    // Half-open run [begin, end) of entry indices
+    struct EntryInterval {
+        size_t begin = 0;
+        size_t end = 0;
+    };
+
+    // Resolves line and frame range predicates to runs of entry indices without visiting every entry.
+    // Line numbers grow with the entry index, so a line range is two binary searches over the store;
+    // frame numbers only grow roughly, so a min/max summary per block of entries rules blocks out.
+    // Maintained alongside the entry store, like LogCategoryIndex.
+    class EntryRangeIndex {
+        CK_GENERATED_BODY(EntryRangeIndex);
+
+    private:
+        std::vector<int> block_frame_min;   // Per block; INT_MAX when no entry of the block has a frame
+        std::vector<int> block_frame_max;   // Per block; INT_MIN when no entry of the block has a frame
+        size_t last_line_number;
+        bool lines_ascending;               // False if an entry was ever numbered below its predecessor
+        size_t entry_count;
+
+    public:
+        static constexpr size_t kBlockSize = 256;
+
+        EntryRangeIndex() : last_line_number(0), lines_ascending(true), entry_count(0) {}
+
+        // Properties using macros
+        CK_PROPERTY_GET(entry_count);
+        CK_PROPERTY_GET(lines_ascending);
+
+        // Index the entry stored right after the ones indexed so far
+        void AddEntry(const LogEntry& entry);
+
+        // Re-index a whole entry store
+        void Rebuild(const std::vector<LogEntry>& entries);
+        void Clear();
+
+        // Entries whose line number lies in [min_line, max_line] (exact), or every entry when
+        // line numbers are not ascending
+        EntryInterval FindLineInterval(const std::vector<LogEntry>& entries, long long min_line, long long max_line) const;
+
+        // Runs of blocks that may hold frame numbers in [min_frame, max_frame] (a superset of the matches)
+        void FindFrameIntervals(int min_frame, int max_frame, std::vector<EntryInterval>& intervals) const;
+
+        // Set operations on sorted, disjoint interval lists
+        static void Intersect(const std::vector<EntryInterval>& a, const std::vector<EntryInterval>& b,
+                              std::vector<EntryInterval>& result);
+        static void Unite(const std::vector<EntryInterval>& a, const std::vector<EntryInterval>& b,
+                          std::vector<EntryInterval>& result);
+    };
+
+} // namespace ue_log
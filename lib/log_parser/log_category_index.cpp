@@ -0,0 +1,80 @@
+#include "log_category_index.h"
+
+namespace ue_log {
+
+    namespace {
+        const std::vector<uint32_t> kNoEntries;
+    }
+
+    void LogCategoryIndex::AddEntry(const LogEntry& entry) {
+        uint32_t index = static_cast<uint32_t>(entry_count++);
+
+        uint32_t logger_id = Intern(entry.Get_logger_name(), logger_ids, logger_names, logger_entries);
+        logger_entries[logger_id].push_back(index);
+        if (logger_id == logger_color_keys.size()) {
+            logger_color_keys.push_back(ComputeLoggerColorKey(entry.Get_logger_name()));
+        }
+        entry_logger_ids.push_back(logger_id);
+
+        uint32_t level_id = kInvalidId;
+        if (entry.HasLogLevel()) {
+            level_id = Intern(entry.Get_log_level().value(), level_ids, level_names, level_entries);
+            level_entries[level_id].push_back(index);
+        }
+        entry_level_ids.push_back(level_id);
+    }
+
+    void LogCategoryIndex::Rebuild(const std::vector<LogEntry>& entries) {
+        Clear();
+        for (const LogEntry& entry : entries) {
+            AddEntry(entry);
+        }
+    }
+
+    void LogCategoryIndex::Clear() {
+        logger_ids.clear();
+        logger_names.clear();
+        logger_entries.clear();
+        logger_color_keys.clear();
+        level_ids.clear();
+        level_names.clear();
+        level_entries.clear();
+        entry_logger_ids.clear();
+        entry_level_ids.clear();
+        entry_count = 0;
+    }
+
+    uint32_t LogCategoryIndex::FindLoggerId(const std::string& logger_name) const {
+        auto it = logger_ids.find(logger_name);
+        return it != logger_ids.end() ? it->second : kInvalidId;
+    }
+
+    uint32_t LogCategoryIndex::FindLevelId(const std::string& level) const {
+        auto it = level_ids.find(level);
+        return it != level_ids.end() ? it->second : kInvalidId;
+    }
+
+    const std::vector<uint32_t>& LogCategoryIndex::GetLoggerEntries(const std::string& logger_name) const {
+        uint32_t id = FindLoggerId(logger_name);
+        return id != kInvalidId ? logger_entries[id] : kNoEntries;
+    }
+
+    const std::vector<uint32_t>& LogCategoryIndex::GetLevelEntries(const std::string& level) const {
+        uint32_t id = FindLevelId(level);
+        return id != kInvalidId ? level_entries[id] : kNoEntries;
+    }
+
+    uint32_t LogCategoryIndex::Intern(const std::string& name, std::unordered_map<std::string, uint32_t>& ids,
+                                      std::vector<std::string>& names, std::vector<std::vector<uint32_t>>& entries) {
+        auto it = ids.find(name);
+        if (it != ids.end()) {
+            return it->second;
+        }
+        uint32_t id = static_cast<uint32_t>(names.size());
+        ids.emplace(name, id);
+        names.push_back(name);
+        entries.emplace_back();
+        return id;
+    }
+
+} // namespace ue_log
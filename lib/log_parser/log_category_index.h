@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../../macros.h"
+#include "../common/logger_color_key.h"
+#include "log_entry.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace ue_log {
+
+    // Posting lists of entry indices per logger name and per log level, maintained while entries
+    // are parsed or appended. Logger and level filters then walk only the entries they match.
+    // Names are interned into dense ids in order of first appearance. Each logger id also gets a color key,
+    // a hash of its name, so badge colors are picked by id and stay the same across sessions.
+    class LogCategoryIndex {
+        CK_GENERATED_BODY(LogCategoryIndex);
+
+    private:
+        std::unordered_map<std::string, uint32_t> logger_ids;
+        std::vector<std::string> logger_names;              // Logger id -> name
+        std::vector<std::vector<uint32_t>> logger_entries;  // Logger id -> ascending entry indices
+        std::vector<uint32_t> logger_color_keys;            // Logger id -> ComputeLoggerColorKey(name)
+        std::unordered_map<std::string, uint32_t> level_ids;
+        std::vector<std::string> level_names;               // Level id -> name
+        std::vector<std::vector<uint32_t>> level_entries;   // Level id -> ascending entry indices
+        std::vector<uint32_t> entry_logger_ids;             // Entry index -> logger id
+        std::vector<uint32_t> entry_level_ids;              // Entry index -> level id (kInvalidId without a level)
+        size_t entry_count;
+
+    public:
+        static constexpr uint32_t kInvalidId = UINT32_MAX;
+
+        LogCategoryIndex() : entry_count(0) {}
+
+        // Properties using macros
+        CK_PROPERTY_GET(logger_names);
+        CK_PROPERTY_GET(level_names);
+        CK_PROPERTY_GET(entry_count);
+
+        // Index the entry stored right after the ones indexed so far
+        void AddEntry(const LogEntry& entry);
+
+        // Re-index a whole entry store
+        void Rebuild(const std::vector<LogEntry>& entries);
+        void Clear();
+
+        // Dense ids; kInvalidId when the name never occurred
+        uint32_t FindLoggerId(const std::string& logger_name) const;
+        uint32_t FindLevelId(const std::string& level) const;
+
+        // Ids of one indexed entry
+        uint32_t GetEntryLoggerId(size_t entry_index) const { return entry_logger_ids[entry_index]; }
+        uint32_t GetEntryLevelId(size_t entry_index) const { return entry_level_ids[entry_index]; }
+
+        // Color key of a logger id / of one indexed entry's logger
+        uint32_t GetLoggerColorKey(uint32_t logger_id) const { return logger_color_keys[logger_id]; }
+        uint32_t GetEntryLoggerColorKey(size_t entry_index) const { return logger_color_keys[entry_logger_ids[entry_index]]; }
+
+        // Ascending indices of the entries with exactly this logger name / level (empty when unknown)
+        const std::vector<uint32_t>& GetLoggerEntries(const std::string& logger_name) const;
+        const std::vector<uint32_t>& GetLevelEntries(const std::string& level) const;
+
+    private:
+        static uint32_t Intern(const std::string& name, std::unordered_map<std::string, uint32_t>& ids,
+                               std::vector<std::string>& names, std::vector<std::vector<uint32_t>>& entries);
+    };
+
+} // namespace ue_log
@@ -54,6 +54,8 @@ namespace ue_log {
             current_file_path = file_path;
             current_line_number = 0;
             parsed_entries.clear();
+            category_index.Clear();
+            range_index.Clear();
             cached_file_size = file_size;
             
             // Parse all entries immediately
@@ -486,6 +488,10 @@ namespace ue_log {
         // Update parsed entries
         parsed_entries.reserve(parsed_entries.size() + entries.size());
         parsed_entries.insert(parsed_entries.end(), entries.begin(), entries.end());
+        for (const LogEntry& entry : entries) {
+            category_index.AddEntry(entry);
+            range_index.AddEntry(entry);
+        }
         current_line_number = line_number + lines.size();
         
         return entries;
@@ -583,6 +589,8 @@ namespace ue_log {
         current_file_path.clear();
         current_line_number = 0;
         parsed_entries.clear();
+        category_index.Clear();
+        range_index.Clear();
         cached_file_size = 0;
     }
     
@@ -3,6 +3,8 @@
 #include "../../macros.h"
 #include "../common/result.h"
 #include "log_entry.h"
+#include "log_category_index.h"
+#include "entry_range_index.h"
 #include <mio/mmap.hpp>
 #include <string>
 #include <vector>
@@ -17,6 +19,8 @@ namespace ue_log {
     private:
         std::unique_ptr<mio::mmap_source> memory_map;
         std::vector<LogEntry> parsed_entries;
+        LogCategoryIndex category_index;      // Logger/level posting lists over parsed_entries
+        EntryRangeIndex range_index;          // Line/frame range lookups over parsed_entries
         std::regex structured_pattern;        // [timestamp][frame]Logger: Level: message
         std::regex semi_structured_pattern;   // [timestamp][frame]Logger: message
         std::regex unstructured_pattern;      // Logger: Level: message
@@ -34,6 +38,8 @@ namespace ue_log {
         
         // Properties using macros
         CK_PROPERTY_GET(parsed_entries);
+        CK_PROPERTY_GET(category_index);
+        CK_PROPERTY_GET(range_index);
         CK_PROPERTY_GET(current_file_path);
         CK_PROPERTY_GET(current_line_number);
         
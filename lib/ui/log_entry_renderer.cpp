@@ -1,4 +1,5 @@
 #include "log_entry_renderer.h"
+#include "../common/string_search.h"
 #include <ftxui/dom/elements.hpp>
 #include <ftxui/screen/color.hpp>
 #include <algorithm>
@@ -8,6 +9,41 @@ namespace ue_log {
 
 using namespace ftxui;
 
+namespace {
+    // Message bytes [begin, end) as text, with the parts covered by spans highlighted. next_span is the first span
+    // not yet fully drawn; a span running past end stays current, so it continues on the next wrapped line
+    Element SliceHighlightedLine(const std::string& message, size_t begin, size_t end,
+                                 const string_search::MatchSpan* spans, size_t span_count, size_t& next_span) {
+        if (next_span == span_count || spans[next_span].offset >= end) {
+            return text(message.substr(begin, end - begin));
+        }
+        
+        std::vector<Element> segments;
+        size_t pos = begin;
+        while (next_span < span_count && spans[next_span].offset < end) {
+            size_t span_end = static_cast<size_t>(spans[next_span].offset) + spans[next_span].length;
+            size_t match_begin = std::max<size_t>(spans[next_span].offset, pos);
+            size_t match_end = std::min(span_end, end);
+            if (match_begin > pos) {
+                segments.push_back(text(message.substr(pos, match_begin - pos)));
+            }
+            if (match_end > match_begin) {
+                segments.push_back(text(message.substr(match_begin, match_end - match_begin)) |
+                                   bgcolor(Color::Yellow) | color(Color::Black) | bold);
+                pos = match_end;
+            }
+            if (span_end > end) {
+                break;
+            }
+            ++next_span;
+        }
+        if (pos < end) {
+            segments.push_back(text(message.substr(pos, end - pos)));
+        }
+        return hbox(std::move(segments));
+    }
+}
+
 LogEntryRenderer::LogEntryRenderer(VisualThemeManager* theme_manager)
     : theme_manager_(theme_manager) {
     if (!theme_manager_) {
@@ -16,42 +52,25 @@ LogEntryRenderer::LogEntryRenderer(VisualThemeManager* theme_manager)
 }
 
 Element LogEntryRenderer::RenderLogEntry(const LogEntry& entry, bool is_selected, 
-                                        int relative_line_number) const {
+                                        int relative_line_number, size_t row_id) const {
     std::vector<Element> row_elements;
     
-    // Get column spacing configuration
-    auto spacing = theme_manager_->GetColumnSpacing();
-    
-    // Line number column (if enabled)
+    // Line number column (if enabled) - depends on the selection, so never cached
     if (show_line_numbers_) {
         row_elements.push_back(RenderLineNumber(relative_line_number, is_selected));
         row_elements.push_back(CreateSeparator());
     }
     
-    // Timestamp column
-    row_elements.push_back(RenderTimestamp(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Frame number column
-    row_elements.push_back(RenderFrameNumber(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Logger badge column
-    row_elements.push_back(RenderLoggerBadge(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Log level column
-    row_elements.push_back(RenderLogLevel(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Message column (flexible width)
-    row_elements.push_back(RenderMessage(entry, is_selected) | flex);
+    // Timestamp, frame, logger, level and message columns
+    const CachedRow& cached = GetRowColumns(row_id, entry, "", false);
+    row_elements.insert(row_elements.end(), cached.columns.begin(), cached.columns.end());
     
     // Create the row with proper spacing
-    Element row = hbox(row_elements);
+    Element row = hbox(std::move(row_elements));
     
     // Apply row-level visual hierarchy - always apply to maintain column alignment
-    std::string level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : "";
+    static const std::string kNoLevel;
+    const std::string& level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : kNoLevel;
     row = ApplyRowLevelHierarchy(row, level, is_selected);
     
     // Apply selection highlighting (after hierarchy styling to ensure it takes precedence)
@@ -188,12 +207,17 @@ Element LogEntryRenderer::RenderFrameNumber(const LogEntry& entry) const {
     return element | color(theme_manager_->GetMutedTextColor());
 }
 
-Element LogEntryRenderer::RenderLoggerBadge(const LogEntry& entry) const {
+Element LogEntryRenderer::RenderLoggerBadge(const LogEntry& entry, size_t row_id) const {
     auto spacing = theme_manager_->GetColumnSpacing();
-    std::string logger_name = entry.Get_logger_name();
+    const std::string& logger_name = entry.Get_logger_name();
     
-    // Get consistent color for this logger
-    Color logger_color = theme_manager_->GetLoggerColor(logger_name);
+    // Get consistent color for this logger; indexed rows carry the key computed when the logger was interned
+    Color logger_color;
+    if (category_index_ && row_id < category_index_->Get_entry_count()) {
+        logger_color = theme_manager_->GetLoggerColorByKey(category_index_->GetEntryLoggerColorKey(row_id));
+    } else {
+        logger_color = theme_manager_->GetLoggerColor(logger_name);
+    }
     
     // Create badge with truncated logger name if necessary
     std::string badge_text = TruncateText(logger_name, spacing.logger_badge_width - 2);
@@ -227,21 +251,25 @@ Element LogEntryRenderer::RenderMessage(const LogEntry& entry, bool is_selected)
         message_element = text(entry.Get_message());
     }
     
+    return ApplyMessageLevelStyling(message_element, entry);
+}
+
+Element LogEntryRenderer::ApplyMessageLevelStyling(Element element, const LogEntry& entry) const {
     // Apply visual hierarchy to message content for prominent log levels
     if (entry.Get_log_level().has_value()) {
         const std::string& level = entry.Get_log_level().value();
         if (theme_manager_->IsLogLevelProminent(level)) {
             Color level_color = theme_manager_->GetLogLevelColor(level);
-            message_element = message_element | color(level_color);
+            element = element | color(level_color);
             
             // Make error messages bold for better readability
             if (level == "Error") {
-                message_element = message_element | bold;
+                element = element | bold;
             }
         }
     }
     
-    return message_element;
+    return element;
 }
 
 Element LogEntryRenderer::CreateBadgeElement(const std::string& text, Color color) const {
@@ -305,6 +333,62 @@ std::string LogEntryRenderer::PadText(const std::string& text, int width) const
     return text + std::string(width - text.length(), ' ');
 }
 
+int LogEntryRenderer::GetFixedColumnsWidth() const {
+    auto spacing = theme_manager_->GetColumnSpacing();
+    std::string separator = theme_manager_->GetColumnSeparator();
+    int separator_width = WrapLayout::CountColumns(separator.data(), separator.data() + separator.size());
+    
+    // Hierarchy indicator, then timestamp, frame, logger and level columns, each followed by a separator
+    int width = 1;
+    if (show_line_numbers_) {
+        width += spacing.line_number_width + separator_width;
+    }
+    width += spacing.timestamp_width + separator_width;
+    width += spacing.frame_width + separator_width;
+    width += spacing.logger_badge_width + separator_width;
+    width += spacing.level_width + separator_width;
+    return width;
+}
+
+int LogEntryRenderer::EstimateRowHeight(const LogEntry& entry, int row_width, size_t row_id) const {
+    if (!word_wrap_enabled_) {
+        return 1;
+    }
+    
+    int message_width = row_width - GetFixedColumnsWidth();
+    if (message_width <= 0) {
+        return 1;
+    }
+    
+    return static_cast<int>(GetMessageLayout(entry, row_id, message_width).GetLineCount());
+}
+
+const WrapLayout& LogEntryRenderer::GetMessageLayout(const LogEntry& entry, size_t row_id, int message_width) const {
+    if (row_id == kUncachedRow) {
+        uncached_layout_ = WrapLayout(entry.Get_message(), message_width);
+        return uncached_layout_;
+    }
+    return message_layouts_.Get(row_id, entry.Get_message(), message_width);
+}
+
+Element LogEntryRenderer::RenderWrappedMessage(const LogEntry& entry, const WrapLayout& layout,
+                                               const string_search::MatchSpan* spans, size_t span_count) const {
+    const std::string& message = entry.Get_message();
+    
+    // Only the lines are built here; where they break was decided once by the layout,
+    // and where the matches are by the search
+    std::vector<Element> lines;
+    lines.reserve(layout.GetLineCount());
+    size_t next_span = 0;
+    for (size_t i = 0; i < layout.GetLineCount(); ++i) {
+        const WrapLayout::Line& line = layout.GetLine(i);
+        lines.push_back(SliceHighlightedLine(message, line.begin, std::min(line.end, message.size()),
+                                             spans, span_count, next_span));
+    }
+    
+    return ApplyMessageLevelStyling(vbox(std::move(lines)), entry);
+}
+
 Element LogEntryRenderer::ApplyRowLevelHierarchy(Element element, const std::string& level, bool is_selected) const {
     // Get the appropriate indicator color for this log level
     Color indicator_color;
@@ -447,62 +531,28 @@ Element LogEntryRenderer::RenderLogEntryWithSearchHighlight(const LogEntry& entr
                                                            int relative_line_number,
                                                            const std::string& search_query, 
                                                            bool case_sensitive,
-                                                           bool is_filter_highlight) const {
+                                                           bool is_filter_highlight,
+                                                           size_t row_id,
+                                                           const RowMatchSpans& match_spans) const {
     std::vector<Element> row_elements;
     
-    // Get column spacing configuration
-    auto spacing = theme_manager_->GetColumnSpacing();
-    
-    // Line number column (if enabled)
+    // Line number column (if enabled) - depends on the selection, so never cached
     if (show_line_numbers_) {
         row_elements.push_back(RenderLineNumber(relative_line_number, is_selected));
         row_elements.push_back(CreateSeparator());
     }
     
-    // Timestamp column
-    row_elements.push_back(RenderTimestamp(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Frame number column
-    row_elements.push_back(RenderFrameNumber(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Logger badge column
-    row_elements.push_back(RenderLoggerBadge(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Log level column
-    row_elements.push_back(RenderLogLevel(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Message column with search highlighting (flexible width)
-    row_elements.push_back(RenderMessageWithSearchHighlight(entry, is_selected, search_query, case_sensitive) | flex);
+    // Timestamp through message columns, with the search term highlighted in the message
+    const CachedRow& cached = GetRowColumns(row_id, entry, search_query, case_sensitive, match_spans);
+    row_elements.insert(row_elements.end(), cached.columns.begin(), cached.columns.end());
     
     // Create the row with proper spacing
-    Element row = hbox(row_elements);
-    
-    // Check if this entry contains a search match
-    bool is_search_match = false;
-    if (!search_query.empty()) {
-        std::string search_text = entry.Get_message() + " " + entry.Get_logger_name();
-        if (entry.Get_log_level().has_value()) {
-            search_text += " " + entry.Get_log_level().value();
-        }
-        
-        if (case_sensitive) {
-            is_search_match = search_text.find(search_query) != std::string::npos;
-        } else {
-            std::string lower_query = search_query;
-            std::string lower_text = search_text;
-            std::transform(lower_query.begin(), lower_query.end(), lower_query.begin(), ::tolower);
-            std::transform(lower_text.begin(), lower_text.end(), lower_text.begin(), ::tolower);
-            is_search_match = lower_text.find(lower_query) != std::string::npos;
-        }
-    }
+    Element row = hbox(std::move(row_elements));
     
     // Apply row-level visual hierarchy with search indication
-    std::string level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : "";
-    row = ApplyRowLevelHierarchyWithSearch(row, level, is_selected, is_search_match, is_filter_highlight);
+    static const std::string kNoLevel;
+    const std::string& level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : kNoLevel;
+    row = ApplyRowLevelHierarchyWithSearch(row, level, is_selected, cached.is_search_match, is_filter_highlight);
     
     // Apply selection highlighting (after hierarchy styling to ensure it takes precedence)
     if (is_selected) {
@@ -515,84 +565,26 @@ Element LogEntryRenderer::RenderLogEntryWithSearchHighlight(const LogEntry& entr
 Element LogEntryRenderer::RenderMessageWithSearchHighlight(const LogEntry& entry, bool is_selected, 
                                                           const std::string& search_query, 
                                                           bool case_sensitive) const {
-    using namespace ftxui;
-    
     if (search_query.empty()) {
         return RenderMessage(entry, is_selected);
     }
     
-    std::string message = entry.Get_message();
-    std::vector<Element> elements;
-    
-    // Find all matches in the message
-    std::vector<size_t> match_positions;
-    
-    if (case_sensitive) {
-        // Case-sensitive: search directly in original message
-        size_t pos = 0;
-        while ((pos = message.find(search_query, pos)) != std::string::npos) {
-            match_positions.push_back(pos);
-            pos += search_query.length();
-        }
-    } else {
-        // Case-insensitive: find positions but validate against original text
-        std::string search_text = message;
-        std::string query = search_query;
-        std::transform(search_text.begin(), search_text.end(), search_text.begin(), ::tolower);
-        std::transform(query.begin(), query.end(), query.begin(), ::tolower);
-        
-        size_t pos = 0;
-        while ((pos = search_text.find(query, pos)) != std::string::npos) {
-            // Validate that this position makes sense in the original text
-            if (pos + search_query.length() <= message.length()) {
-                match_positions.push_back(pos);
-            }
-            pos += query.length();
-        }
-    }
-    
-    if (match_positions.empty()) {
-        return RenderMessage(entry, is_selected);
-    }
-    
-    // Build highlighted message with bounds checking
-    size_t last_pos = 0;
-    
-    for (size_t match_pos : match_positions) {
-        // Validate match position is within bounds
-        if (match_pos >= message.length()) {
-            continue; // Skip invalid positions
-        }
-        
-        // Add text before the match
-        if (match_pos > last_pos) {
-            size_t before_length = match_pos - last_pos;
-            if (last_pos + before_length <= message.length()) {
-                std::string before_match = message.substr(last_pos, before_length);
-                // Always use text() for consistency in hbox - word wrapping handled at higher level
-                elements.push_back(text(before_match));
-            }
-        }
-        
-        // Add highlighted match - always use original search_query length
-        size_t match_length = search_query.length();
-        if (match_pos + match_length <= message.length()) {
-            std::string match_text = message.substr(match_pos, match_length);
-            Element highlighted_match = text(match_text) | bgcolor(Color::Yellow) | color(Color::Black) | bold;
-            elements.push_back(highlighted_match);
-            
-            last_pos = match_pos + match_length;
-        }
-    }
-    
-    // Add remaining text after the last match
-    if (last_pos < message.length()) {
-        std::string after_matches = message.substr(last_pos);
-        // Always use text() for consistency in hbox - word wrapping handled at higher level
-        elements.push_back(text(after_matches));
+    // Search directly in the original message; case folding happens inside the matcher
+    std::vector<string_search::MatchSpan> spans;
+    string_search::SubstringMatcher(search_query, case_sensitive).FindAll(entry.Get_message(), spans);
+    return RenderMessageWithMatchSpans(entry, spans.data(), spans.size());
+}
+
+Element LogEntryRenderer::RenderMessageWithMatchSpans(const LogEntry& entry, const string_search::MatchSpan* spans,
+                                                      size_t span_count) const {
+    if (span_count == 0) {
+        return RenderMessage(entry, false);
     }
     
-    Element result = hbox(elements);
+    // Always text() segments in an hbox - word wrapping is handled by RenderWrappedMessage
+    const std::string& message = entry.Get_message();
+    size_t next_span = 0;
+    Element result = SliceHighlightedLine(message, 0, message.size(), spans, span_count, next_span);
     
     // Apply word wrapping if enabled - handle at the container level
     if (word_wrap_enabled_) {
@@ -604,42 +596,26 @@ Element LogEntryRenderer::RenderMessageWithSearchHighlight(const LogEntry& entry
 
 Element LogEntryRenderer::RenderLogEntryWithVisualSelection(const LogEntry& entry, bool is_selected, 
                                                            bool is_visual_selected,
-                                                           int relative_line_number) const {
+                                                           int relative_line_number,
+                                                           size_t row_id) const {
     std::vector<Element> row_elements;
     
-    // Get column spacing configuration
-    auto spacing = theme_manager_->GetColumnSpacing();
-    
-    // Line number column (if enabled)
+    // Line number column (if enabled) - depends on the selection, so never cached
     if (show_line_numbers_) {
         row_elements.push_back(RenderLineNumber(relative_line_number, is_selected));
         row_elements.push_back(CreateSeparator());
     }
     
-    // Timestamp column
-    row_elements.push_back(RenderTimestamp(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Frame number column
-    row_elements.push_back(RenderFrameNumber(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Logger badge column
-    row_elements.push_back(RenderLoggerBadge(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Log level column
-    row_elements.push_back(RenderLogLevel(entry));
-    row_elements.push_back(CreateSeparator());
-    
-    // Message column (flexible width)
-    row_elements.push_back(RenderMessage(entry, is_selected) | flex);
+    // Timestamp, frame, logger, level and message columns
+    const CachedRow& cached = GetRowColumns(row_id, entry, "", false);
+    row_elements.insert(row_elements.end(), cached.columns.begin(), cached.columns.end());
     
     // Create the row with proper spacing
-    Element row = hbox(row_elements);
+    Element row = hbox(std::move(row_elements));
     
     // Apply row-level visual hierarchy - always apply to maintain column alignment
-    std::string level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : "";
+    static const std::string kNoLevel;
+    const std::string& level = entry.Get_log_level().has_value() ? entry.Get_log_level().value() : kNoLevel;
     row = ApplyRowLevelHierarchy(row, level, is_selected);
     
     // Apply visual selection highlighting first (takes precedence over normal selection)
@@ -654,6 +630,124 @@ Element LogEntryRenderer::RenderLogEntryWithVisualSelection(const LogEntry& entr
     return row;
 }
 
+void LogEntryRenderer::BeginFrame(int row_width) {
+    ++frame_counter_;
+    
+    if (row_width != cache_row_width_) {
+        row_cache_.clear();
+        cache_row_width_ = row_width;
+        return;
+    }
+    
+    // Rows scrolled off screen are only dropped once the cache is large, so scrolling back is free
+    if (row_cache_.size() > kMaxCachedRows) {
+        uint64_t previous_frame = frame_counter_ - 1;
+        for (auto it = row_cache_.begin(); it != row_cache_.end();) {
+            if (it->second.last_used_frame < previous_frame) {
+                it = row_cache_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+}
+
+void LogEntryRenderer::ClearRowCache() {
+    row_cache_.clear();
+    message_layouts_.Clear();
+}
+
+const LogEntryRenderer::CachedRow& LogEntryRenderer::GetRowColumns(size_t row_id, const LogEntry& entry,
+                                                                   const std::string& search_query,
+                                                                   bool case_sensitive,
+                                                                   const RowMatchSpans& match_spans) const {
+    if (row_id == kUncachedRow) {
+        BuildRowColumns(row_id, entry, search_query, case_sensitive, match_spans, uncached_row_);
+        return uncached_row_;
+    }
+    
+    // Any change to the inputs shared by every row invalidates all of them
+    uint64_t theme_generation = theme_manager_->GetThemeGeneration();
+    bool term_changed = search_query != cache_highlight_term_ ||
+                        (!search_query.empty() && case_sensitive != cache_case_sensitive_);
+    if (theme_generation != cache_theme_generation_ || word_wrap_enabled_ != cache_word_wrap_ || term_changed) {
+        row_cache_.clear();
+        cache_theme_generation_ = theme_generation;
+        cache_word_wrap_ = word_wrap_enabled_;
+        cache_highlight_term_ = search_query;
+        cache_case_sensitive_ = case_sensitive;
+    }
+    
+    auto [it, inserted] = row_cache_.try_emplace(row_id);
+    if (inserted) {
+        BuildRowColumns(row_id, entry, search_query, case_sensitive, match_spans, it->second);
+    }
+    it->second.last_used_frame = frame_counter_;
+    return it->second;
+}
+
+void LogEntryRenderer::BuildRowColumns(size_t row_id, const LogEntry& entry, const std::string& search_query,
+                                       bool case_sensitive, const RowMatchSpans& match_spans, CachedRow& row) const {
+    row.columns.clear();
+    row.columns.reserve(9);
+    
+    // Timestamp column
+    row.columns.push_back(RenderTimestamp(entry));
+    row.columns.push_back(CreateSeparator());
+    
+    // Frame number column
+    row.columns.push_back(RenderFrameNumber(entry));
+    row.columns.push_back(CreateSeparator());
+    
+    // Logger badge column
+    row.columns.push_back(RenderLoggerBadge(entry, row_id));
+    row.columns.push_back(CreateSeparator());
+    
+    // Log level column
+    row.columns.push_back(RenderLogLevel(entry));
+    row.columns.push_back(CreateSeparator());
+    
+    // Message column (flexible width); is_selected does not affect the message, so false is passed.
+    // Wrapped messages are stacks of lines from the cached layout, so the row's height matches EstimateRowHeight
+    // Match spans come from the search pass when it already scanned this row; otherwise they are found here once
+    const string_search::MatchSpan* spans = match_spans.spans;
+    size_t span_count = match_spans.span_count;
+    std::vector<string_search::MatchSpan> found_spans;
+    if (!match_spans.known && !search_query.empty()) {
+        string_search::SubstringMatcher(search_query, case_sensitive).FindAll(entry.Get_message(), found_spans);
+        spans = found_spans.data();
+        span_count = found_spans.size();
+    }
+    
+    int message_width = cache_row_width_ - GetFixedColumnsWidth();
+    if (word_wrap_enabled_ && message_width > 0) {
+        const WrapLayout& layout = GetMessageLayout(entry, row_id, message_width);
+        row.columns.push_back(RenderWrappedMessage(entry, layout, spans, span_count) | flex);
+    } else if (search_query.empty()) {
+        row.columns.push_back(RenderMessage(entry, false) | flex);
+    } else {
+        row.columns.push_back(RenderMessageWithMatchSpans(entry, spans, span_count) | flex);
+    }
+    if (search_query.empty()) {
+        row.is_search_match = false;
+        return;
+    }
+    if (match_spans.known) {
+        row.is_search_match = match_spans.is_match;
+        return;
+    }
+    
+    // Check if this entry contains a search match (fields are searched in place, without copies)
+    if (span_count > 0) {
+        row.is_search_match = true;
+        return;
+    }
+    string_search::SubstringMatcher matcher(search_query, case_sensitive);
+    row.is_search_match = matcher.Matches(entry.Get_message()) ||
+                          matcher.Matches(entry.Get_logger_name()) ||
+                          (entry.Get_log_level().has_value() && matcher.Matches(entry.Get_log_level().value()));
+}
+
 Element LogEntryRenderer::ApplyVisualSelectionHighlight(Element element, bool is_visual_selected) const {
     if (!is_visual_selected) {
         return element;
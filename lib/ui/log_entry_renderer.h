@@ -2,11 +2,28 @@
 
 #include "visual_theme_manager.h"
 #include "../log_parser/log_entry.h"
+#include "../log_parser/log_category_index.h"
+#include "../core/wrap_layout.h"
+#include "../common/string_search.h"
 #include <ftxui/dom/elements.hpp>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace ue_log {
 
+/**
+ * What a search pass already found in one row, so highlighting only slices the message.
+ */
+struct RowMatchSpans {
+    bool known = false;    // False if the row was not searched yet; the renderer then finds the matches itself
+    bool is_match = false; // The row is a search result (its message, logger or level matched)
+    const string_search::MatchSpan* spans = nullptr; // Matches in the message, in order
+    size_t span_count = 0;
+};
+
 /**
  * Handles rendering of individual log entries with enhanced visual formatting.
  * Provides logger badge system, proper column spacing, and visual hierarchy.
@@ -24,6 +41,12 @@ public:
      */
     ~LogEntryRenderer() = default;
     
+    // Row id for entries that should not be cached (always rendered from scratch)
+    static constexpr size_t kUncachedRow = SIZE_MAX;
+    
+    // Rows kept before off-screen rows are evicted
+    static constexpr size_t kMaxCachedRows = 2048;
+    
     // Main rendering methods
     
     /**
@@ -31,10 +54,12 @@ public:
      * @param entry The log entry to render
      * @param is_selected Whether this entry is currently selected
      * @param relative_line_number Optional relative line number for vim-style display
+     * @param row_id Stable id of the entry for the row cache, or kUncachedRow
      * @return FTXUI Element representing the rendered log entry
      */
     ftxui::Element RenderLogEntry(const LogEntry& entry, bool is_selected, 
-                                 int relative_line_number = 0) const;
+                                 int relative_line_number = 0,
+                                 size_t row_id = kUncachedRow) const;
     
     /**
      * Render a complete log entry with search highlighting.
@@ -44,13 +69,17 @@ public:
      * @param search_query The search query to highlight
      * @param case_sensitive Whether the search is case sensitive
      * @param is_filter_highlight Whether this is a filter highlight (vs search highlight)
+     * @param row_id Stable id of the entry for the row cache, or kUncachedRow
+     * @param match_spans Matches recorded by the search pass for this row, if known
      * @return FTXUI Element representing the rendered log entry with search highlighting
      */
     ftxui::Element RenderLogEntryWithSearchHighlight(const LogEntry& entry, bool is_selected, 
                                                      int relative_line_number,
                                                      const std::string& search_query, 
                                                      bool case_sensitive,
-                                                     bool is_filter_highlight = false) const;
+                                                     bool is_filter_highlight = false,
+                                                     size_t row_id = kUncachedRow,
+                                                     const RowMatchSpans& match_spans = RowMatchSpans()) const;
     
     /**
      * Render the table header with column labels.
@@ -85,9 +114,10 @@ public:
     /**
      * Render logger badge with consistent color assignment.
      * @param entry The log entry containing logger name
+     * @param row_id Index of the entry in the category index, to take its precomputed color key; or kUncachedRow
      * @return FTXUI Element for the logger badge
      */
-    ftxui::Element RenderLoggerBadge(const LogEntry& entry) const;
+    ftxui::Element RenderLoggerBadge(const LogEntry& entry, size_t row_id = kUncachedRow) const;
     
     /**
      * Render log level column with appropriate styling.
@@ -116,17 +146,49 @@ public:
                                                    const std::string& search_query, 
                                                    bool case_sensitive) const;
     
+    /**
+     * Render message column with precomputed matches highlighted.
+     * @param entry The log entry containing the message
+     * @param spans Matches in the message, in order
+     * @param span_count Number of matches
+     * @return FTXUI Element for the message column with the matches highlighted
+     */
+    ftxui::Element RenderMessageWithMatchSpans(const LogEntry& entry, const string_search::MatchSpan* spans,
+                                               size_t span_count) const;
+    
     /**
      * Render a complete log entry with visual selection highlighting.
      * @param entry The log entry to render
      * @param is_selected Whether this entry is currently selected
      * @param is_visual_selected Whether this entry is part of visual selection
      * @param relative_line_number Optional relative line number for vim-style display
+     * @param row_id Stable id of the entry for the row cache, or kUncachedRow
      * @return FTXUI Element representing the rendered log entry with visual selection highlighting
      */
     ftxui::Element RenderLogEntryWithVisualSelection(const LogEntry& entry, bool is_selected, 
                                                     bool is_visual_selected,
-                                                    int relative_line_number = 0) const;
+                                                    int relative_line_number = 0,
+                                                    size_t row_id = kUncachedRow) const;
+    
+    // Row element cache
+    
+    /**
+     * Start a new frame of rows. Drops the cache when the row width changed and,
+     * once the cache holds more than kMaxCachedRows rows, evicts rows not drawn in the previous frame.
+     * @param row_width Width available to one row
+     */
+    void BeginFrame(int row_width);
+    
+    /**
+     * Drop every cached row; call when the entries behind the row ids are replaced.
+     */
+    void ClearRowCache();
+    
+    /**
+     * Get the number of rows currently cached.
+     * @return Cached row count
+     */
+    size_t GetCachedRowCount() const { return row_cache_.size(); }
     
     // Configuration methods
     
@@ -142,6 +204,12 @@ public:
      */
     void SetShowLineNumbers(bool show) { show_line_numbers_ = show; }
     
+    /**
+     * Set the category index of the entries that row ids refer to; logger colors are then looked up by id.
+     * @param category_index Index kept in sync with the entry store, or nullptr to hash logger names per row
+     */
+    void SetCategoryIndex(const LogCategoryIndex* category_index) { category_index_ = category_index; }
+    
     /**
      * Check if word wrapping is enabled.
      * @return True if word wrapping is enabled
@@ -153,7 +221,27 @@ public:
      * @return True if line numbers are shown
      */
     bool IsShowLineNumbers() const { return show_line_numbers_; }
-    
+
+    // Layout queries
+
+    /**
+     * Width of everything in a row before the message column
+     * (hierarchy indicator, line number, timestamp, frame, logger, level and separators).
+     * @return Width in terminal cells
+     */
+    int GetFixedColumnsWidth() const;
+
+    /**
+     * Get how many terminal lines an entry occupies in a row of the given width.
+     * Always 1 unless word wrapping is enabled; wrapped rows take their height from the cached message layout,
+     * so this is O(1) once the row has been laid out at that width.
+     * @param entry The log entry to measure
+     * @param row_width Total width available to the row
+     * @param row_id Stable id of the entry for the layout cache, or kUncachedRow
+     * @return Number of lines (at least 1)
+     */
+    int EstimateRowHeight(const LogEntry& entry, int row_width, size_t row_id = kUncachedRow) const;
+
     /**
      * Apply consistent visual polish to UI elements.
      * @param element The element to polish
@@ -176,13 +264,89 @@ public:
 private:
     // Dependencies
     VisualThemeManager* theme_manager_;
+    const LogCategoryIndex* category_index_ = nullptr;
     
     // Configuration
     bool word_wrap_enabled_ = false;
     bool show_line_numbers_ = true;
     
+    // Everything in a row that does not depend on selection or line numbering:
+    // timestamp through message columns with their separators, plus the row's search match flag
+    struct CachedRow {
+        std::vector<ftxui::Element> columns;
+        bool is_search_match = false;
+        uint64_t last_used_frame = 0;
+    };
+    
+    // Rows keyed by row id; valid for the inputs below and rebuilt when any of them changes
+    mutable std::unordered_map<size_t, CachedRow> row_cache_;
+    mutable CachedRow uncached_row_;
+    mutable uint64_t cache_theme_generation_ = 0;
+    mutable bool cache_word_wrap_ = false;
+    mutable std::string cache_highlight_term_;
+    mutable bool cache_case_sensitive_ = false;
+    int cache_row_width_ = 0;
+    uint64_t frame_counter_ = 0;
+    
+    // Line breaks of wrapped messages keyed by row id; each layout remembers the width it was built for
+    mutable WrapLayoutCache message_layouts_;
+    mutable WrapLayout uncached_layout_;
+    
     // Helper methods
     
+    /**
+     * Get the cached columns of a row, building them on a miss.
+     * @param row_id Stable id of the entry, or kUncachedRow
+     * @param entry The log entry to render
+     * @param search_query Term highlighted in the message (empty for none)
+     * @param case_sensitive Whether the highlight is case sensitive
+     * @param match_spans Matches of search_query already found by the search pass, if known
+     * @return Cached row, valid until the next call
+     */
+    const CachedRow& GetRowColumns(size_t row_id, const LogEntry& entry,
+                                   const std::string& search_query, bool case_sensitive,
+                                   const RowMatchSpans& match_spans = RowMatchSpans()) const;
+    
+    /**
+     * Build the timestamp through message columns of a row.
+     * @param row_id Stable id of the entry, or kUncachedRow
+     * @param entry The log entry to render
+     * @param search_query Term highlighted in the message (empty for none)
+     * @param case_sensitive Whether the highlight is case sensitive
+     * @param match_spans Matches of search_query already found by the search pass, if known
+     * @param row Row to fill
+     */
+    void BuildRowColumns(size_t row_id, const LogEntry& entry, const std::string& search_query,
+                         bool case_sensitive, const RowMatchSpans& match_spans, CachedRow& row) const;
+    
+    /**
+     * Get the wrap layout of an entry's message, building it on a miss.
+     * @param entry The log entry
+     * @param row_id Stable id of the entry, or kUncachedRow
+     * @param message_width Width of the message column
+     * @return Layout, valid until the next call
+     */
+    const WrapLayout& GetMessageLayout(const LogEntry& entry, size_t row_id, int message_width) const;
+    
+    /**
+     * Render a word-wrapped message as one element per layout line, with matches highlighted.
+     * @param entry The log entry containing the message
+     * @param layout Layout of the message
+     * @param spans Matches in the message, in order
+     * @param span_count Number of matches
+     * @return FTXUI Element for the message column
+     */
+    ftxui::Element RenderWrappedMessage(const LogEntry& entry, const WrapLayout& layout,
+                                        const string_search::MatchSpan* spans, size_t span_count) const;
+    
+    /**
+     * Apply the message color and weight of the entry's log level.
+     * @param element The message element to style
+     * @param entry The log entry containing the log level
+     * @return Styled FTXUI Element
+     */
+    ftxui::Element ApplyMessageLevelStyling(ftxui::Element element, const LogEntry& entry) const;
+    
     /**
      * Create a badge element with text and background color.
      * @param text The text to display in the badge
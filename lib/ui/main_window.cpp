@@ -1,12 +1,18 @@
 #include "main_window.h"
+#include "../common/parallel_for.h"
+#include "../filter_engine/expression_plan.h"
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/component_base.hpp>
 #include <ftxui/component/component_options.hpp>
 #include <ftxui/component/event.hpp>
 #include <ftxui/dom/elements.hpp>
 #include <ftxui/screen/color.hpp>
+#include <ftxui/screen/terminal.hpp>
 #include <filesystem>
 #include <algorithm>
+#include <numeric>
+#include <optional>
+#include <cstdio>
 #include <chrono>
 #include <sstream>
 #include <fstream>
@@ -24,6 +30,8 @@ public:
     MainWindowComponent(MainWindow* parent) : parent_(parent) {}
     
     Element Render() override {
+        PerfCounters::ScopedTimer frame_timer(parent_->perf_counters_, PerfCounters::FrameBuild);
+        parent_->BeginFrame();
         return parent_->Render();
     }
     
@@ -89,6 +97,15 @@ public:
         // Debug: Log all events
         // std::cout << "Event received" << std::endl;
         
+        // Input can change any pane; the frame that follows the event rebuilds them all
+        parent_->redraw_scheduler_.MarkDirty(RedrawScheduler::All);
+        
+        // Mouse motion arrives constantly and is not waited on, so only keys and clicks are timed
+        std::optional<PerfCounters::ScopedTimer> event_timer;
+        if (!event.is_mouse() || event.mouse().motion == Mouse::Pressed) {
+            event_timer.emplace(parent_->perf_counters_, PerfCounters::EventHandling);
+        }
+        
         // Handle file browser mode events first
         if (parent_->GetMode() == MainWindow::EApplicationMode::FileBrowser) {
             // Let file browser handle its events
@@ -111,6 +128,11 @@ public:
             return HandleVisualSelectionEvent(event);
         }
         
+        // Clicking the minimap jumps to that part of the log
+        if (event.is_mouse()) {
+            return parent_->HandleMinimapClick(event.mouse());
+        }
+        
         // Handle ESC key - priority order matters!
         if (event == Event::Escape) {
             // 1. First check vim command mode
@@ -262,6 +284,18 @@ public:
             return true;
         }
         
+        // Minimap toggle
+        if (event == Event::Character('m')) {
+            parent_->ToggleMinimap();
+            return true;
+        }
+        
+        // Performance HUD toggle
+        if (event == Event::F12) {
+            parent_->TogglePerfHud();
+            return true;
+        }
+        
         if (event == Event::Character('h') || event == Event::F1) {
             // Toggle help - placeholder for now
             return true;
@@ -762,6 +796,10 @@ MainWindow::MainWindow(ConfigManager* config_manager)
 }
 
 MainWindow::~MainWindow() {
+    // The file monitor thread requests redraws, so it is stopped before the scheduler goes away
+    StopFileMonitoring();
+    redraw_scheduler_.Stop();
+    
     // Clean up owned config manager
     if (_Owns_Config_Manager_) {
         delete _Config_Manager_;
@@ -788,6 +826,7 @@ void MainWindow::Initialize() {
     // Initialize visual components
     if (_Visual_Theme_Manager_) {
         _Log_Entry_Renderer_ = std::make_unique<LogEntryRenderer>(_Visual_Theme_Manager_.get());
+        _Log_Entry_Renderer_->SetCategoryIndex(&category_index_); // Row ids are indices into log_entries_
     }
     
     // Apply basic configuration
@@ -830,8 +869,16 @@ ftxui::Element MainWindow::RenderLogViewerMode() const {
     // Main layout: log table + detail view + status bar
     std::vector<Element> main_elements;
     
+    // Panes are rebuilt only when their region was dirtied since the last frame
+    auto pane = [this](uint32_t region, Element& cached, auto build) -> Element {
+        if (!cached || (frame_dirty_regions_ & region)) {
+            cached = build();
+        }
+        return cached;
+    };
+    
     // Add log table (takes most of the space)
-    main_elements.push_back(RenderLogTable() | flex);
+    main_elements.push_back(pane(RedrawScheduler::Table, table_pane_, [this] { return RenderLogTable(); }) | flex);
     
     // Add detail view if enabled (shows full raw log entry)
     if (show_detail_view_) {
@@ -842,7 +889,13 @@ ftxui::Element MainWindow::RenderLogViewerMode() const {
         int detail_height = detail_view_focused_ ? 
                            std::max(15, available_height * 2 / 3) :  // 2/3 of screen when focused
                            5;                                        // 5 lines when not focused
-        main_elements.push_back(RenderDetailView() | size(HEIGHT, EQUAL, detail_height));
+        main_elements.push_back(pane(RedrawScheduler::DetailView, detail_pane_, [this] { return RenderDetailView(); }) |
+                                size(HEIGHT, EQUAL, detail_height));
+    }
+    
+    // Add performance HUD if enabled; its numbers change every frame, so it is never cached
+    if (show_perf_hud_) {
+        main_elements.push_back(RenderPerfHud());
     }
     
     // Add search status bar if active (appears above main status bar)
@@ -851,14 +904,15 @@ ftxui::Element MainWindow::RenderLogViewerMode() const {
     }
     
     // Add status bar at the bottom
-    main_elements.push_back(RenderStatusBar());
+    main_elements.push_back(pane(RedrawScheduler::StatusBar, status_pane_, [this] { return RenderStatusBar(); }));
     
     // Combine into vertical layout
     Element main_content = vbox(main_elements);
     
     // Add filter panel if enabled (on the left side)
     if (show_filter_panel_ && _Filter_Panel_) {
-        Element filter_panel = _Filter_Panel_->Render() | size(WIDTH, EQUAL, 60);
+        Element filter_panel = pane(RedrawScheduler::FilterPanel, filter_panel_pane_,
+                                    [this] { return _Filter_Panel_->Render(); }) | size(WIDTH, EQUAL, 60);
         main_content = hbox({
             filter_panel,
             separator(),
@@ -892,6 +946,7 @@ bool MainWindow::LoadLogFile(const std::string& file_path) {
     if (_File_Monitor_ && _File_Monitor_->IsMonitoring()) {
         _File_Monitor_->StopMonitoring();
     }
+    DiscardTailedLines(); // Lines tailed from the previous file
     
     // Store the file path
     _Current_File_Path_ = file_path;
@@ -908,7 +963,17 @@ bool MainWindow::LoadLogFile(const std::string& file_path) {
         _Last_Error_ = "Loading and parsing log file...";
         
         // Get the already-parsed entries from the log parser
+        ResetSearchIndex(); // The index builder reads log_entries_, so it is stopped before replacing them
+        if (_Log_Entry_Renderer_) {
+            _Log_Entry_Renderer_->ClearRowCache(); // Cached rows are keyed by log_entries_ index
+        }
+        detail_layouts_.Clear();
         log_entries_ = _Log_Parser_->Get_parsed_entries();
+        category_index_ = _Log_Parser_->Get_category_index(); // Built while parsing
+        range_index_ = _Log_Parser_->Get_range_index();
+        if (_Filter_Engine_) {
+            _Filter_Engine_->ResetMatchBitmaps(); // Cached filter matches refer to the previous entries
+        }
         
         if (log_entries_.empty()) {
             // If no entries were parsed, create sample data as fallback
@@ -923,6 +988,9 @@ bool MainWindow::LoadLogFile(const std::string& file_path) {
         // Apply filters
         OnFiltersChanged();
         
+        // Index the messages in the background; searches scan normally until the index is ready
+        StartSearchIndexBuild();
+        
         // Reset scroll position and selection
         scroll_offset_ = 0;
         selected_entry_index_ = 0;
@@ -976,9 +1044,7 @@ void MainWindow::SetMode(EApplicationMode mode) {
     }
     
     // Trigger screen refresh
-    if (refresh_callback_) {
-        refresh_callback_();
-    }
+    RequestRedraw(RedrawScheduler::All);
 }
 
 void MainWindow::InitializeFileBrowser(const std::string& directory_path) {
@@ -995,16 +1061,12 @@ void MainWindow::InitializeFileBrowser(const std::string& directory_path) {
     
     _File_Browser_->SetErrorCallback([this](const std::string& error) {
         SetLastError(error);
-        if (refresh_callback_) {
-            refresh_callback_();
-        }
+        RequestRedraw(RedrawScheduler::StatusBar);
     });
     
     _File_Browser_->SetStatusCallback([this](const std::string& status) {
         SetLastError(status);  // Use SetLastError for positive status messages too
-        if (refresh_callback_) {
-            refresh_callback_();
-        }
+        RequestRedraw(RedrawScheduler::StatusBar);
     });
     
     // Switch to file browser mode
@@ -1023,9 +1085,7 @@ void MainWindow::TransitionToLogViewer(const std::string& file_path) {
     }
     
     // Trigger screen refresh
-    if (refresh_callback_) {
-        refresh_callback_();
-    }
+    RequestRedraw(RedrawScheduler::All);
 }
 
 void MainWindow::OnFileSelected(const std::string& file_path) {
@@ -1203,15 +1263,30 @@ bool MainWindow::RunAutotest(const std::string& log_file_path, const std::string
 void MainWindow::CloseCurrentFile() {
     // Clear all file-related state
     _Current_File_Path_.clear();
+    StopFileMonitoring();
+    DiscardTailedLines();
+    ResetSearchIndex();
+    search_executor_.Cancel(); // The scan reads filtered_entries_, which is cleared below
+    if (_Log_Entry_Renderer_) {
+        _Log_Entry_Renderer_->ClearRowCache();
+    }
+    detail_layouts_.Clear();
     log_entries_.clear();
+    category_index_.Clear();
+    range_index_.Clear();
     filtered_entries_.clear();
+    filtered_log_indices_.clear();
+    ResetFilteredLevelRows();
+    if (_Filter_Engine_) {
+        _Filter_Engine_->ResetMatchBitmaps();
+    }
+    RestartSearchScan();
     selected_entry_index_ = 0;
     scroll_offset_ = 0;
     _Last_Error_.clear();
     
-    // Stop any real-time monitoring and file monitoring
+    // Stop any real-time monitoring
     StopRealTimeMonitoring();
-    StopFileMonitoring();
     
     // Reset tailing state
     is_tailing_ = false;
@@ -1242,9 +1317,9 @@ void MainWindow::StartFileMonitoring() {
     
     // Only set up callback and start monitoring if not already running
     if (!_File_Monitor_->IsMonitoring()) {
-        // Set up FileMonitor callback to OnNewLogLines
+        // FileMonitor calls back on its own thread; the lines are applied by the UI thread in BeginFrame
         _File_Monitor_->SetCallback([this](const std::string& file_path, const std::vector<std::string>& new_lines) {
-            OnNewLogLines(new_lines);
+            QueueTailedLines(new_lines);
         });
         
         // Configure poll interval (default 100ms for background monitoring)
@@ -1265,121 +1340,116 @@ void MainWindow::StopFileMonitoring() {
 }
 
 void MainWindow::ApplyFiltersToNewEntries(const std::vector<LogEntry>& new_entries) {
+    // Appending may reallocate filtered_entries_; a running search resumes from where it stopped.
+    // Runs on the UI thread, which is the only one that starts or cancels the search executor
+    search_executor_.Cancel();
+    
     if (!_Filter_Engine_) {
         // No filter engine - just append all new entries
+        size_t first_new_index = log_entries_.size() - new_entries.size();
         filtered_entries_.insert(filtered_entries_.end(), new_entries.begin(), new_entries.end());
+        for (size_t i = 0; i < new_entries.size(); ++i) {
+            filtered_log_indices_.push_back(first_new_index + i);
+        }
         return;
     }
     
+    // New entries were appended to the tail of log_entries_, so their indices are known
+    size_t first_new_index = log_entries_.size() - new_entries.size();
+    std::vector<size_t> new_match_indices;
+    
     // Check if we have hierarchical filters (contextual filters)
     if (current_filter_expression_ && !current_filter_expression_->IsEmpty()) {
         // Apply hierarchical filters to new entries only
-        for (const auto& entry : new_entries) {
-            if (current_filter_expression_->Matches(entry)) {
-                filtered_entries_.push_back(entry);
+        ExpressionPlan plan(*current_filter_expression_, log_entries_);
+        for (size_t i = 0; i < new_entries.size(); ++i) {
+            if (plan.Matches(new_entries[i])) {
+                new_match_indices.push_back(first_new_index + i);
             }
         }
     } else {
-        // Apply traditional filters to new entries only
-        const auto& filters = _Filter_Engine_->Get_primary_filters();
-        
-        // Check if there are any active filters
-        bool has_active_filters = false;
-        for (const auto& filter : filters) {
-            if (filter->Get_is_active()) {
-                has_active_filters = true;
-                break;
-            }
-        }
-        
-        if (!has_active_filters) {
-            // No active filters - append all new entries
-            filtered_entries_.insert(filtered_entries_.end(), new_entries.begin(), new_entries.end());
-        } else {
-            // Apply active filters to new entries
-            for (const auto& entry : new_entries) {
-                bool matches_any_filter = false;
-                
-                for (const auto& filter : filters) {
-                    if (filter->Get_is_active() && filter->Matches(entry)) {
-                        matches_any_filter = true;
-                        break;
-                    }
-                }
-                
-                if (matches_any_filter) {
-                    filtered_entries_.push_back(entry);
-                }
+        // Apply traditional filters to new entries only, with the same AND logic as a full refilter
+        auto plan = _Filter_Engine_->GetCompiledPlan();
+        for (size_t i = 0; i < new_entries.size(); ++i) {
+            if (plan->MatchesAll(new_entries[i])) {
+                new_match_indices.push_back(first_new_index + i);
             }
         }
     }
     
-    // Handle context lines if needed - do this incrementally to avoid full rebuild
+    // Handle context lines incrementally - only the tail of the context ranges is touched
     if (context_lines_ > 0) {
-        // For incremental updates with context, we need to add context around new matching entries
-        // This avoids the expensive full rebuild that OnFiltersChanged() would cause
-        ApplyContextToNewEntries(new_entries);
+        ApplyContextToNewEntries(new_match_indices);
+        return;
+    }
+    
+    for (size_t index : new_match_indices) {
+        filtered_entries_.push_back(log_entries_[index]);
+        filtered_log_indices_.push_back(index);
     }
 }
 
-void MainWindow::ApplyContextToNewEntries(const std::vector<LogEntry>& new_entries) {
-    if (context_lines_ == 0 || new_entries.empty()) {
-        return; // No context needed or no new entries
+void MainWindow::ApplyContextToNewEntries(const std::vector<size_t>& new_match_indices) {
+    if (context_lines_ == 0) {
+        return; // No context needed
     }
     
-    // For each new entry that was added to filtered_entries_, we need to check if we should
-    // add context lines around it. This is more complex than a full rebuild, but avoids
-    // the performance issue of re-processing the entire log.
-    
-    // Get the current size of filtered_entries_ before we start adding context
-    size_t original_filtered_size = filtered_entries_.size();
-    
-    // We need to be careful here - the filtered_entries_ already contains the new entries
-    // that passed the filter. We need to add context around those entries.
+    size_t context = static_cast<size_t>(context_lines_);
     
-    // For incremental context, we'll use a simpler approach:
-    // 1. Find the positions of the new entries in the original log_entries_
-    // 2. Add context lines around those positions if they're not already in filtered_entries_
-    
-    std::set<size_t> entries_to_add; // Use set to avoid duplicates
-    
-    // Find positions of new entries in the original log
-    for (const auto& new_entry : new_entries) {
-        // Find this entry in log_entries_ to get its position
-        for (size_t i = 0; i < log_entries_.size(); ++i) {
-            if (log_entries_[i].Get_line_number() == new_entry.Get_line_number()) {
-                // Add context lines around this position
-                size_t start_pos = (i >= context_lines_) ? i - context_lines_ : 0;
-                size_t end_pos = std::min(i + context_lines_ + 1, log_entries_.size());
-                
-                for (size_t j = start_pos; j < end_pos; ++j) {
-                    entries_to_add.insert(j);
-                }
-                break;
-            }
-        }
+    // Finish the trailing context of earlier matches that ran past the old end of the log
+    if (!context_ranges_.empty()) {
+        AppendContextRange(context_ranges_.back().end, context_pending_end_);
     }
     
-    // Add the context entries that aren't already in filtered_entries_
-    // We need to check if each entry is already present to avoid duplicates
-    std::set<int> existing_line_numbers;
-    for (const auto& entry : filtered_entries_) {
-        existing_line_numbers.insert(entry.Get_line_number());
+    // New matches are sorted and lie at the tail, so each one only extends the last range
+    for (size_t match_index : new_match_indices) {
+        size_t start_index = (match_index >= context) ? match_index - context : 0;
+        AppendContextRange(start_index, match_index + context + 1);
+        MarkContextMatch(match_index);
+        context_pending_end_ = match_index + context + 1;
+    }
+}
+
+void MainWindow::AppendContextRange(size_t begin, size_t end) {
+    // Never re-emit entries already covered by the last range
+    if (!context_ranges_.empty()) {
+        begin = std::max(begin, context_ranges_.back().end);
+    }
+    end = std::min(end, log_entries_.size());
+    if (begin >= end) {
+        return;
     }
     
-    // Add new context entries
-    for (size_t pos : entries_to_add) {
-        const auto& entry = log_entries_[pos];
-        if (existing_line_numbers.find(entry.Get_line_number()) == existing_line_numbers.end()) {
-            filtered_entries_.push_back(entry);
-        }
+    filtered_entries_.insert(filtered_entries_.end(),
+                             log_entries_.begin() + begin, log_entries_.begin() + end);
+    for (size_t index = begin; index < end; ++index) {
+        filtered_log_indices_.push_back(index);
     }
+    context_match_flags_.resize(filtered_entries_.size(), false);
     
-    // Sort filtered_entries_ by line number to maintain proper order
-    std::sort(filtered_entries_.begin(), filtered_entries_.end(), 
-              [](const LogEntry& a, const LogEntry& b) {
-                  return a.Get_line_number() < b.Get_line_number();
-              });
+    // Merge with the last range when contiguous
+    if (!context_ranges_.empty() && context_ranges_.back().end == begin) {
+        context_ranges_.back().end = end;
+    } else {
+        context_ranges_.push_back({begin, end});
+    }
+}
+
+void MainWindow::MarkContextMatch(size_t match_index) {
+    // The match always lies inside the last range, which ends at the back of filtered_entries_
+    if (context_ranges_.empty() || match_index >= context_ranges_.back().end) {
+        return;
+    }
+    size_t view_index = filtered_entries_.size() - (context_ranges_.back().end - match_index);
+    context_match_flags_[view_index] = true;
+}
+
+bool MainWindow::IsContextEntry(size_t view_index) const {
+    // Without context every visible entry is a match; entries without a flag are treated as matches too
+    if (context_lines_ == 0 || view_index >= context_match_flags_.size()) {
+        return false;
+    }
+    return !context_match_flags_[view_index];
 }
 
 void MainWindow::GoToTop() {
@@ -1450,12 +1520,14 @@ void MainWindow::ScrollDown(int count) {
 }
 
 void MainWindow::PageUp() {
-    int page_size = std::max(1, window_height_ - 3);
+    // One screen of table rows, the same height RenderLogTable fills
+    int page_size = std::max(1, GetVisibleHeight());
     ScrollUp(page_size);
 }
 
 void MainWindow::PageDown() {
-    int page_size = std::max(1, window_height_ - 3);
+    // One screen of table rows, the same height RenderLogTable fills
+    int page_size = std::max(1, GetVisibleHeight());
     ScrollDown(page_size);
 }
 
@@ -1547,10 +1619,18 @@ void MainWindow::OnNewLogLines(const std::vector<std::string>& new_lines) {
         size_t current_line_num = log_entries_.size() + 1; // Continue line numbering
         std::vector<LogEntry> new_entries;
         
+        // Appending may reallocate log_entries_ under a running index build, so it is restarted afterwards;
+        // a finished index stays valid and the appended entries are scanned directly. This runs on the UI thread
+        // (tailed lines are queued by QueueTailedLines), the same one that acquires and resets the index
+        bool restart_index_build = search_index_builder_.IsBuilding();
+        search_index_builder_.Cancel();
+        
         for (const auto& line : new_lines) {
             auto entry = _Log_Parser_->ParseSingleEntry(line, current_line_num);
             // Add new entry to log_entries_ vector
             log_entries_.push_back(entry);
+            category_index_.AddEntry(entry);
+            range_index_.AddEntry(entry);
             new_entries.push_back(entry);
             current_line_num++;
         }
@@ -1558,17 +1638,18 @@ void MainWindow::OnNewLogLines(const std::vector<std::string>& new_lines) {
         // Apply filters only to new entries and append to filtered_entries_
         ApplyFiltersToNewEntries(new_entries);
         
+        if (restart_index_build) {
+            StartSearchIndexBuild();
+        }
+        
 
         // Auto-scroll to bottom ONLY if tailing is active and auto-scroll is enabled
+        uint32_t dirty_regions = RedrawScheduler::Table | RedrawScheduler::StatusBar;
         if (is_tailing_ && auto_scroll_enabled_) {
             AutoScrollToBottom();
             // Ensure the selection is visible after auto-scrolling
             EnsureSelectionVisible();
-        }
-        
-        // Always trigger screen refresh when new entries are added (regardless of tailing state)
-        if (refresh_callback_) {
-            refresh_callback_();
+            dirty_regions |= RedrawScheduler::DetailView; // The selection moved to the new last entry
         }
         
         // Update status message based on tailing state
@@ -1578,6 +1659,10 @@ void MainWindow::OnNewLogLines(const std::vector<std::string>& new_lines) {
             _Last_Error_ = "STATIC - " + std::filesystem::path(_Current_File_Path_).filename().string() + " (updated)";
         }
         
+        // Redraw when new entries are added (regardless of tailing state); bursts of batches
+        // are coalesced into frames at no more than the maximum redraw rate
+        RequestRedraw(dirty_regions);
+        
     } catch (const std::exception& e) {
         // Handle parsing errors gracefully
         if (is_tailing_) {
@@ -1588,6 +1673,49 @@ void MainWindow::OnNewLogLines(const std::vector<std::string>& new_lines) {
     }
 }
 
+void MainWindow::QueueTailedLines(const std::vector<std::string>& new_lines) {
+    if (new_lines.empty()) {
+        return;
+    }
+    
+    // The lines now wait for the next frame; BeginFrame applies them and records how many and for how long
+    {
+        std::lock_guard<std::mutex> lock(ingest_mutex_);
+        if (ingest_pending_lines_ == 0) {
+            ingest_pending_since_ = std::chrono::steady_clock::now();
+        }
+        ingest_pending_batch_.insert(ingest_pending_batch_.end(), new_lines.begin(), new_lines.end());
+        ingest_pending_lines_ += new_lines.size();
+    }
+    RequestRedraw(RedrawScheduler::Table | RedrawScheduler::StatusBar);
+}
+
+void MainWindow::ApplyTailedLines() {
+    std::vector<std::string> batch;
+    std::chrono::steady_clock::time_point oldest_arrival;
+    {
+        std::lock_guard<std::mutex> lock(ingest_mutex_);
+        if (ingest_pending_lines_ == 0) {
+            return;
+        }
+        batch.swap(ingest_pending_batch_);
+        oldest_arrival = ingest_pending_since_;
+        perf_counters_.Record(PerfCounters::IngestQueueDepth, static_cast<double>(ingest_pending_lines_));
+        ingest_pending_lines_ = 0;
+    }
+    
+    OnNewLogLines(batch);
+    
+    // Tailed lines shown for the first time in this frame
+    perf_counters_.Record(PerfCounters::IngestLatency, PerfCounters::MillisecondsSince(oldest_arrival));
+}
+
+void MainWindow::DiscardTailedLines() {
+    std::lock_guard<std::mutex> lock(ingest_mutex_);
+    ingest_pending_batch_.clear();
+    ingest_pending_lines_ = 0;
+}
+
 void MainWindow::ApplyConfiguration() {
     // Basic configuration - use defaults for now
     show_line_numbers_ = true;
@@ -1610,10 +1738,120 @@ int MainWindow::GetVisibleHeight() const {
             std::max(15, available_height * 2 / 3) : 5;
     }
     
+    if (show_perf_hud_) {
+        reserved_space += kPerfHudHeight;
+    }
+    
     // Calculate visible height for log entries
     return std::max(5, available_height - reserved_space);
 }
 
+int MainWindow::GetLogRowWidth() const {
+    int available_width = (window_width_ > 0) ? window_width_ : 120;
+    
+    if (show_filter_panel_ && _Filter_Panel_) {
+        available_width -= 61; // Filter panel and its separator
+    }
+    
+    // Outer border, window frame, the one-column scrollbar and the minimap if shown
+    int reserved_width = 5 + (show_minimap_ ? kMinimapWidth : 0);
+    return std::max(1, available_width - reserved_width);
+}
+
+int MainWindow::GetDetailViewWidth() const {
+    int available_width = (window_width_ > 0) ? window_width_ : 120;
+    if (show_filter_panel_ && _Filter_Panel_) {
+        available_width -= 61; // Filter panel and its separator
+    }
+    
+    // Outer border and window frame, plus the focus border when focused
+    int reserved_width = detail_view_focused_ ? 6 : 4;
+    return std::max(1, available_width - reserved_width);
+}
+
+int MainWindow::GetDetailViewVisibleHeight() const {
+    // Use a reasonable fallback if window_height_ is not set
+    int available_height = (window_height_ > 0) ? window_height_ : 30; // Fallback to 30 lines
+    int content_height = available_height - 2; // Exclude status bars
+    return detail_view_focused_ ?
+           std::max(10, (content_height * 2) / 3 - 4) :  // 2/3 of screen when focused, -4 for window borders
+           3;                                            // 3 lines when not focused
+}
+
+const WrapLayout* MainWindow::GetDetailViewLayout() const {
+    if (selected_entry_index_ < 0 || selected_entry_index_ >= static_cast<int>(filtered_entries_.size())) {
+        return nullptr;
+    }
+    return &detail_layouts_.Get(filtered_log_indices_[selected_entry_index_],
+                                filtered_entries_[selected_entry_index_].Get_raw_line(), GetDetailViewWidth());
+}
+
+std::pair<int, int> MainWindow::GetVisibleRowRange(int visible_height) const {
+    int total_entries = static_cast<int>(filtered_entries_.size());
+    if (total_entries == 0 || visible_height <= 0) {
+        return {0, 0};
+    }
+    
+    int selected = std::clamp(selected_entry_index_, 0, total_entries - 1);
+    
+    if (!word_wrap_enabled_ || !_Log_Entry_Renderer_) {
+        // Fixed-height rows: a window of visible_height rows from scroll_offset_,
+        // pulled back in range and shifted just enough to contain the selection
+        int first = std::clamp(scroll_offset_, 0, std::max(0, total_entries - visible_height));
+        if (selected < first) {
+            first = selected;
+        } else if (selected >= first + visible_height) {
+            first = selected - visible_height + 1;
+        }
+        return {first, std::min(total_entries, first + visible_height)};
+    }
+    
+    // Word-wrapped rows have variable height: fill the screen from scroll_offset_ by wrapped height
+    int row_width = GetLogRowWidth();
+    auto row_height = [&](int index) {
+        return _Log_Entry_Renderer_->EstimateRowHeight(filtered_entries_[index], row_width, filtered_log_indices_[index]);
+    };
+    
+    int first = std::clamp(scroll_offset_, 0, total_entries - 1);
+    if (selected < first) {
+        first = selected;
+    }
+    
+    int end = first;
+    int used = 0;
+    while (end < total_entries && used < visible_height) {
+        used += row_height(end);
+        ++end;
+    }
+    
+    if (selected >= end || (used > visible_height && selected == end - 1 && end - 1 > first)) {
+        // Selection fell below the screen: anchor it to the bottom and fill upwards
+        end = selected + 1;
+        first = selected;
+        used = row_height(selected);
+        while (first > 0) {
+            int height = row_height(first - 1);
+            if (used + height > visible_height) {
+                break;
+            }
+            used += height;
+            --first;
+        }
+    } else if (used < visible_height && end == total_entries) {
+        // Reached the last entry with space left: pull earlier rows in instead of leaving a gap
+        while (first > 0) {
+            int height = row_height(first - 1);
+            if (used + height > visible_height) {
+                break;
+            }
+            used += height;
+            --first;
+        }
+    }
+    
+    return {first, end};
+}
+
 ftxui::Element MainWindow::RenderLogTable() const {
     std::vector<Element> rows;
     
@@ -1628,37 +1866,22 @@ ftxui::Element MainWindow::RenderLogTable() const {
             rows.push_back(text("No entries match the current filters.") | center);
         }
     } else {
-        // Performance optimization: Only render entries that are likely to be visible
-        // Calculate a reasonable window size with buffer for scrolling
+        // Virtualized list: only the rows that fit on screen are turned into elements,
+        // so the per-frame cost does not depend on the number of entries or the jump distance
         int visible_height = GetVisibleHeight();
-        int buffer = visible_height * 2; // Add buffer for smooth scrolling
         
-        // Calculate start and end indices with buffer around selected entry
-        int total_entries = static_cast<int>(filtered_entries_.size());
-        int start_idx = std::max(0, std::min(selected_entry_index_ - buffer, total_entries - visible_height - buffer));
-        int end_idx = std::min(total_entries, start_idx + visible_height + buffer * 2);
-        
-        // If in visual selection mode, ensure the entire selection is included in the render window
-        // but only for small selections to avoid interfering with scrolling
-        if (visual_selection_mode_) {
-            auto range = GetVisualSelectionRange();
-            if (range.first >= 0 && range.second >= 0) {
-                int selection_size = range.second - range.first + 1;
-            }
+        // Renderer settings and highlight state are the same for every row of the frame
+        if (_Log_Entry_Renderer_) {
+            _Log_Entry_Renderer_->SetWordWrapEnabled(word_wrap_enabled_);
+            _Log_Entry_Renderer_->SetShowLineNumbers(show_line_numbers_);
+            _Log_Entry_Renderer_->BeginFrame(GetLogRowWidth());
         }
+        RowRenderContext context = BuildRowRenderContext();
         
-        // Render entries in the window
-        for (int i = start_idx; i < end_idx; ++i) {
+        auto [first_row, end_row] = GetVisibleRowRange(visible_height);
+        for (int i = first_row; i < end_row; ++i) {
             bool is_selected = (i == selected_entry_index_);
-            rows.push_back(RenderLogEntry(filtered_entries_[i], is_selected));
-        }
-        
-        // Add indicators if we're not showing all entries
-        if (start_idx > 0) {
-            rows.insert(rows.begin() + 1, text("↑ More entries above ↑") | center | dim);
-        }
-        if (end_idx < total_entries) {
-            rows.push_back(text("↓ More entries below ↓") | center | dim);
+            rows.push_back(RenderLogEntry(static_cast<size_t>(i), is_selected, context));
         }
     }
     
@@ -1668,17 +1891,23 @@ ftxui::Element MainWindow::RenderLogTable() const {
     // Create scrollable content that fills available space
     Element scrollable_content = vbox(rows) | yframe | yflex;
     
-    // Add custom scrollbar if we have entries
+    // Add custom scrollbar (and the minimap, if shown) if we have entries
     if (!filtered_entries_.empty()) {
         Element custom_scrollbar = RenderCustomScrollbar();
-        scrollable_content = hbox({
-            scrollable_content | flex,
-            custom_scrollbar
-        });
+        if (show_minimap_) {
+            scrollable_content = hbox({
+                scrollable_content | flex,
+                RenderMinimap(),
+                custom_scrollbar
+            });
+        } else {
+            scrollable_content = hbox({
+                scrollable_content | flex,
+                custom_scrollbar
+            });
+        }
     }
     
-    // We'll rely on EnsureSelectionVisible to handle scrolling to the selected entry
-    
     Element window_element = window(text(GetTitle()), scrollable_content);
     
     if (main_has_focus) {
@@ -1843,36 +2072,23 @@ ftxui::Element MainWindow::RenderDetailView() const {
                          _Visual_Theme_Manager_->GetFocusColor() :
                          _Visual_Theme_Manager_->GetHighlightColor());
     
-    // Use the full raw line instead of just the parsed message
-    std::string full_message = selected_entry.Get_raw_line();
-    
-    // Split message into lines for individual line navigation
-    std::vector<std::string> message_lines;
-    std::stringstream ss(full_message);
-    std::string line;
-    while (std::getline(ss, line)) {
-        message_lines.push_back(line);
-    }
-    
-    // If no lines (empty message), add a placeholder
-    if (message_lines.empty()) {
-        message_lines.push_back("(empty message)");
-    }
+    // Use the full raw line instead of just the parsed message, wrapped once per width;
+    // the scroll offset indexes the wrapped lines, so only the visible ones are built
+    const std::string& full_message = selected_entry.Get_raw_line();
+    const WrapLayout* layout = GetDetailViewLayout();
+    int line_count = static_cast<int>(layout->GetLineCount());
     
-    // Calculate visible lines based on focus state and scroll offset
-    // Use a reasonable fallback if window_height_ is not set
-    int available_height = (window_height_ > 0) ? window_height_ : 30; // Fallback to 30 lines
-    int content_height = available_height - 2; // Exclude status bars
-    int visible_height = detail_view_focused_ ? 
-                        std::max(10, (content_height * 2) / 3 - 4) :  // 2/3 of screen when focused, -4 for window borders
-                        3;                                            // 3 lines when not focused
-    int start_line = detail_view_scroll_offset_;
-    int end_line = std::min(start_line + visible_height, static_cast<int>(message_lines.size()));
+    int visible_height = GetDetailViewVisibleHeight();
+    int start_line = std::clamp(detail_view_scroll_offset_, 0, std::max(0, line_count - 1));
+    int end_line = std::min(start_line + visible_height, line_count);
     
     // Create content elements for visible lines
     std::vector<Element> content_elements;
-    for (int i = start_line; i < end_line; i++) {
-        Element line_element = paragraph(message_lines[i]);
+    if (full_message.empty()) {
+        content_elements.push_back(text("(empty message)"));
+    }
+    for (int i = start_line; i < end_line && !full_message.empty(); i++) {
+        Element line_element = text(std::string(layout->GetLineText(full_message, i)));
         
         // Apply log level styling to all lines
         if (selected_entry.Get_log_level().has_value()) {
@@ -1894,9 +2110,9 @@ ftxui::Element MainWindow::RenderDetailView() const {
                                text("... (" + std::to_string(start_line) + " lines above)") | 
                                color(_Visual_Theme_Manager_->GetMutedTextColor()));
     }
-    if (end_line < static_cast<int>(message_lines.size())) {
+    if (end_line < line_count) {
         content_elements.push_back(
-            text("... (" + std::to_string(message_lines.size() - end_line) + " lines below)") | 
+            text("... (" + std::to_string(line_count - end_line) + " lines below)") | 
             color(_Visual_Theme_Manager_->GetMutedTextColor()));
     }
     
@@ -1911,6 +2127,32 @@ ftxui::Element MainWindow::RenderDetailView() const {
     return window_content;
 }
 
+MainWindow::TrackLayout MainWindow::ComputeTrackLayout() const {
+    TrackLayout layout;
+    int total_entries = static_cast<int>(filtered_entries_.size());
+    int visible_height = GetVisibleHeight();
+    
+    // The track runs alongside the table header and its rows
+    layout.track_height = visible_height + 1;
+    layout.histogram_generation = view_histogram_.GetGeneration();
+    layout.theme_generation = _Visual_Theme_Manager_->GetThemeGeneration();
+    if (total_entries == 0) {
+        return layout;
+    }
+    
+    // Thumb covers the rows actually on screen
+    auto [first_row, end_row] = GetVisibleRowRange(visible_height);
+    int64_t track = layout.track_height;
+    int thumb_size = static_cast<int>(std::clamp<int64_t>((end_row - first_row) * track / total_entries, 1, track));
+    int thumb_begin = static_cast<int>(first_row * track / total_entries);
+    if (end_row >= total_entries) {
+        thumb_begin = layout.track_height - thumb_size; // Last row visible: thumb touches the bottom
+    }
+    layout.thumb_begin = std::clamp(thumb_begin, 0, layout.track_height - thumb_size);
+    layout.thumb_end = layout.thumb_begin + thumb_size;
+    return layout;
+}
+
 ftxui::Element MainWindow::RenderCustomScrollbar() const {
     using namespace ftxui;
     
@@ -1918,36 +2160,212 @@ ftxui::Element MainWindow::RenderCustomScrollbar() const {
         return text(" ") | yflex;
     }
     
-    int total_entries = static_cast<int>(filtered_entries_.size());
-    int current_position = selected_entry_index_;
-    int visible_height = GetVisibleHeight();
+    TrackLayout layout = ComputeTrackLayout();
+    if (scrollbar_element_ && layout == scrollbar_layout_) {
+        return scrollbar_element_;
+    }
+    int track_height = layout.track_height;
+    
+    // Classify each cell: thumb, error mark, warning mark or plain track.
+    // Marks come from the histogram, so this is proportional to the track height and bucket count, not the entries.
+    enum class Cell { Track, Thumb, Error, Warning };
+    size_t histogram_rows = view_histogram_.GetRowCount();
+    auto classify = [&](int cell) {
+        if (cell >= layout.thumb_begin && cell < layout.thumb_end) {
+            return Cell::Thumb;
+        }
+        size_t row_begin = static_cast<size_t>(cell) * histogram_rows / track_height;
+        size_t row_end = static_cast<size_t>(cell + 1) * histogram_rows / track_height;
+        row_end = std::max(row_end, row_begin + 1);
+        if (view_histogram_.CountRows(ErrorSeries, row_begin, row_end) > 0) {
+            return Cell::Error;
+        }
+        if (view_histogram_.CountRows(WarningSeries, row_begin, row_end) > 0) {
+            return Cell::Warning;
+        }
+        return Cell::Track;
+    };
     
-    // Use a much larger height to ensure the scrollbar spans the full area
-    // This should be larger than any reasonable window height
-    int scrollbar_height = std::max(50, visible_height * 3);
+    // Runs of identical cells become a single stretched element
+    auto make_run = [&](Cell kind, int length) {
+        Element run;
+        switch (kind) {
+            case Cell::Thumb:
+                run = separatorCharacter("█") | color(Color::White) | bgcolor(Color::Blue);
+                break;
+            case Cell::Error:
+                run = separatorCharacter("┃") | color(_Visual_Theme_Manager_->GetLogLevelColor("Error"));
+                break;
+            case Cell::Warning:
+                run = separatorCharacter("┃") | color(_Visual_Theme_Manager_->GetLogLevelColor("Warning"));
+                break;
+            case Cell::Track:
+                run = separatorCharacter("│") | color(Color::GrayDark);
+                break;
+        }
+        return run | size(HEIGHT, EQUAL, length);
+    };
     
-    // Calculate position and size ratios
-    double position_ratio = static_cast<double>(current_position) / std::max(1, total_entries - 1);
-    double visible_ratio = std::min(1.0, static_cast<double>(visible_height) / static_cast<double>(total_entries));
+    std::vector<Element> runs;
+    Cell run_kind = classify(0);
+    int run_length = 1;
+    for (int cell = 1; cell < track_height; ++cell) {
+        Cell kind = classify(cell);
+        if (kind == run_kind) {
+            ++run_length;
+            continue;
+        }
+        runs.push_back(make_run(run_kind, run_length));
+        run_kind = kind;
+        run_length = 1;
+    }
+    runs.push_back(make_run(run_kind, run_length));
     
-    // Calculate thumb size and position
-    int thumb_size = std::max(2, static_cast<int>(scrollbar_height * visible_ratio));
-    int thumb_position = static_cast<int>((scrollbar_height - thumb_size) * position_ratio);
+    scrollbar_element_ = vbox(std::move(runs)) | size(WIDTH, EQUAL, 1) | yflex;
+    scrollbar_layout_ = layout;
+    return scrollbar_element_;
+}
+
+ftxui::Element MainWindow::RenderMinimap() const {
+    using namespace ftxui;
     
-    // Create scrollbar elements
-    std::vector<Element> scrollbar_elements;
+    TrackLayout layout = ComputeTrackLayout();
+    if (minimap_element_ && layout == minimap_layout_) {
+        return minimap_element_;
+    }
     
-    for (int i = 0; i < scrollbar_height; ++i) {
-        if (i >= thumb_position && i < thumb_position + thumb_size) {
-            // Thumb part - use a solid block character
-            scrollbar_elements.push_back(text("█") | color(Color::White) | bgcolor(Color::Blue));
-        } else {
-            // Track part - use a lighter character
-            scrollbar_elements.push_back(text("│") | color(Color::GrayDark));
+    // Density glyph for the share of a cell's rows that fall in a category; any hit is visible
+    auto density_glyph = [](uint32_t count, size_t rows) -> const char* {
+        if (count == 0) {
+            return " ";
         }
+        double ratio = static_cast<double>(count) / static_cast<double>(std::max<size_t>(rows, 1));
+        if (ratio < 0.1) {
+            return "░";
+        }
+        if (ratio < 0.4) {
+            return "▒";
+        }
+        if (ratio < 0.8) {
+            return "▓";
+        }
+        return "█";
+    };
+    
+    const Color series_colors[kHistogramSeriesCount] = {
+        _Visual_Theme_Manager_->GetLogLevelColor("Error"),
+        _Visual_Theme_Manager_->GetLogLevelColor("Warning"),
+        _Visual_Theme_Manager_->GetAccentColor(),
+        Color::Yellow // Same as the search highlight in rows
+    };
+    
+    // Each cell summarizes an equal share of the view; counts come from the histogram buckets,
+    // so building the minimap costs the same for a thousand rows as for millions
+    size_t total_rows = view_histogram_.GetRowCount();
+    size_t bucket_rows = view_histogram_.GetRowsPerBucket();
+    std::vector<Element> cells;
+    cells.reserve(layout.track_height);
+    for (int cell = 0; cell < layout.track_height; ++cell) {
+        size_t row_begin = static_cast<size_t>(cell) * total_rows / layout.track_height;
+        size_t row_end = std::max(static_cast<size_t>(cell + 1) * total_rows / layout.track_height, row_begin + 1);
+        size_t counted_rows = std::max(row_end - row_begin, bucket_rows);
+        
+        std::vector<Element> columns;
+        for (size_t series = 0; series < kHistogramSeriesCount; ++series) {
+            uint32_t count = view_histogram_.CountRows(series, row_begin, row_end);
+            columns.push_back(text(density_glyph(count, counted_rows)) | color(series_colors[series]));
+        }
+        Element row = hbox(std::move(columns));
+        
+        // Shade the part of the view that is on screen
+        if (cell >= layout.thumb_begin && cell < layout.thumb_end) {
+            row = row | bgcolor(Color::GrayDark);
+        }
+        cells.push_back(row);
+    }
+    
+    minimap_element_ = vbox(std::move(cells)) | size(WIDTH, EQUAL, kMinimapWidth) | reflect(minimap_box_) | yflex;
+    minimap_layout_ = layout;
+    return minimap_element_;
+}
+
+void MainWindow::ToggleMinimap() {
+    show_minimap_ = !show_minimap_;
+    _Last_Error_ = show_minimap_ ? "Minimap shown - columns: errors, warnings, filter matches, search hits"
+                                 : "Minimap hidden";
+}
+
+void MainWindow::JumpToMinimapCell(int cell) {
+    if (filtered_entries_.empty()) {
+        return;
+    }
+    
+    // The cell's first row follows from the same proportional mapping used to draw it
+    int track_height = minimap_layout_.track_height > 0 ? minimap_layout_.track_height : GetVisibleHeight() + 1;
+    cell = std::clamp(cell, 0, track_height - 1);
+    size_t row = static_cast<size_t>(cell) * filtered_entries_.size() / static_cast<size_t>(track_height);
+    
+    if (IsTailing()) {
+        StopTailing();
+    }
+    SelectEntry(static_cast<int>(row));
+}
+
+bool MainWindow::HandleMinimapClick(const ftxui::Mouse& mouse) {
+    if (!show_minimap_ || mouse.button != ftxui::Mouse::Left || mouse.motion != ftxui::Mouse::Pressed ||
+        !minimap_box_.Contain(mouse.x, mouse.y)) {
+        return false;
+    }
+    JumpToMinimapCell(mouse.y - minimap_box_.y_min);
+    return true;
+}
+
+ftxui::Element MainWindow::RenderPerfHud() const {
+    using namespace ftxui;
+    
+    auto format = [](double value, const char* unit) {
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%9.2f %s", value, unit);
+        return std::string(buffer);
+    };
+    
+    std::vector<Element> rows;
+    rows.push_back(hbox({
+        text("") | size(WIDTH, EQUAL, 20),
+        text("      p50") | size(WIDTH, EQUAL, 16),
+        text("      p99") | size(WIDTH, EQUAL, 16),
+        text("     last") | size(WIDTH, EQUAL, 16),
+        text("samples")
+    }) | color(_Visual_Theme_Manager_->GetMutedTextColor()));
+    
+    for (size_t i = 0; i < PerfCounters::kMetricCount; ++i) {
+        PerfCounters::Metric metric = static_cast<PerfCounters::Metric>(i);
+        PerfCounters::Summary summary = perf_counters_.GetSummary(metric);
+        const char* unit = PerfCounters::GetMetricUnit(metric);
+        rows.push_back(hbox({
+            text(PerfCounters::GetMetricName(metric)) | size(WIDTH, EQUAL, 20),
+            text(format(summary.p50, unit)) | size(WIDTH, EQUAL, 16),
+            text(format(summary.p99, unit)) | size(WIDTH, EQUAL, 16),
+            text(format(summary.last, unit)) | size(WIDTH, EQUAL, 16),
+            text(std::to_string(summary.total_count))
+        }));
     }
     
-    return vbox(scrollbar_elements) | size(WIDTH, EQUAL, 1) | yflex;
+    Element title = text("Performance (last " + std::to_string(PerfCounters::kWindowSize) + " samples) - F12 to hide");
+    return window(title, vbox(std::move(rows))) | color(_Visual_Theme_Manager_->GetAccentColor()) |
+           size(HEIGHT, EQUAL, kPerfHudHeight);
+}
+
+void MainWindow::TogglePerfHud() {
+    show_perf_hud_ = !show_perf_hud_;
+    _Last_Error_ = show_perf_hud_ ? "Performance HUD shown" : "Performance HUD hidden";
+}
+
+Result MainWindow::WritePerfCounters() const {
+    if (perf_counters_file_.empty()) {
+        return Result::Success();
+    }
+    return perf_counters_.WriteToFile(perf_counters_file_);
 }
 
 ftxui::Element MainWindow::RenderHelpDialog() const {
@@ -1969,60 +2387,81 @@ ftxui::Element MainWindow::RenderHelpDialog() const {
            size(WIDTH, EQUAL, 40) | size(HEIGHT, EQUAL, 15);
 }
 
-ftxui::Element MainWindow::RenderLogEntry(const LogEntry& entry, bool is_selected) const {
+MainWindow::RowRenderContext MainWindow::BuildRowRenderContext() const {
+    RowRenderContext context;
+    
+    // Priority: active search query first, then selected filter term
+    if (!search_query_.empty()) {
+        context.highlight_term = search_query_;
+    } else {
+        context.highlight_term = GetFilterHighlightTerm();
+    }
+    context.highlight_case_sensitive = HasUppercaseLetters(context.highlight_term);
+    context.is_filter_highlight = search_query_.empty(); // If no active search, this is a filter highlight
+    context.highlight_is_search = !search_query_.empty() && search_query_ == search_scan_query_;
+    
+    if (visual_selection_mode_) {
+        context.visual_range = GetVisualSelectionRange();
+    }
+    return context;
+}
+
+RowMatchSpans MainWindow::GetRowMatchSpans(size_t view_index, const RowRenderContext& context) const {
+    RowMatchSpans match;
+    if (!context.highlight_is_search) {
+        return match; // A filter term: the renderer finds it itself
+    }
+    
+    // Results are in view order; rows the scan has passed without a result are known not to match
+    auto result = std::lower_bound(search_results_.begin(), search_results_.end(), static_cast<int>(view_index));
+    if (result != search_results_.end() && *result == static_cast<int>(view_index)) {
+        size_t result_index = static_cast<size_t>(result - search_results_.begin());
+        match.known = true;
+        match.is_match = true;
+        match.spans = search_result_spans_.GetSpans(result_index);
+        match.span_count = search_result_spans_.GetSpanCount(result_index);
+    } else if (view_index < search_scan_position_) {
+        match.known = true;
+    }
+    return match;
+}
+
+ftxui::Element MainWindow::RenderLogEntry(size_t view_index, bool is_selected, const RowRenderContext& context) const {
+    const LogEntry& entry = filtered_entries_[view_index];
+    int entry_index = static_cast<int>(view_index);
+    
     // Use the LogEntryRenderer if available, otherwise fall back to basic rendering
     if (_Log_Entry_Renderer_) {
-        // Configure the renderer with current settings
-        _Log_Entry_Renderer_->SetWordWrapEnabled(word_wrap_enabled_);
-        _Log_Entry_Renderer_->SetShowLineNumbers(show_line_numbers_);
-        
-        // Find the index of this entry in the filtered entries (used for both relative line numbers and visual selection)
-        int entry_index = -1;
-        for (int i = 0; i < static_cast<int>(filtered_entries_.size()); ++i) {
-            if (&filtered_entries_[i] == &entry) {
-                entry_index = i;
-                break;
-            }
-        }
-        
-        // Calculate relative line number using RelativeLineNumberSystem
+        // Relative line number straight from the view index
         int relative_line_number = 0;
-        if (_Relative_Line_System_ && entry_index >= 0) {
+        if (_Relative_Line_System_) {
             relative_line_number = entry_index - selected_entry_index_;
         }
         
-        // Check if this entry is within visual selection range
-        bool is_visual_selected = false;
-        if (visual_selection_mode_ && entry_index >= 0) {
-            auto range = GetVisualSelectionRange();
-            is_visual_selected = (entry_index >= range.first && entry_index <= range.second);
-        }
+        // Check if this entry is within visual selection range
+        bool is_visual_selected = visual_selection_mode_ &&
+                                  entry_index >= context.visual_range.first && entry_index <= context.visual_range.second;
+        
+        // Rows are cached by their index in log_entries_, which stays stable while filters and selection change
+        size_t row_id = filtered_log_indices_[view_index];
         
         // Render using the appropriate LogEntryRenderer method
         Element row;
-        std::string highlight_term;
-        
-        // Priority: active search query first, then selected filter term
-        if (!search_query_.empty()) {
-            highlight_term = search_query_;
-        } else {
-            highlight_term = GetFilterHighlightTerm();
-        }
         
         // Use visual selection rendering if in visual selection mode
         if (visual_selection_mode_) {
-            row = _Log_Entry_Renderer_->RenderLogEntryWithVisualSelection(entry, is_selected, is_visual_selected, relative_line_number);
-        } else if (!highlight_term.empty()) {
+            row = _Log_Entry_Renderer_->RenderLogEntryWithVisualSelection(entry, is_selected, is_visual_selected, relative_line_number, row_id);
+        } else if (!context.highlight_term.empty()) {
             // Use search highlighting if there's a term to highlight
-            bool case_sensitive = HasUppercaseLetters(highlight_term);
-            bool is_filter_highlight = search_query_.empty(); // If no active search, this is a filter highlight
-            row = _Log_Entry_Renderer_->RenderLogEntryWithSearchHighlight(entry, is_selected, relative_line_number, highlight_term, case_sensitive, is_filter_highlight);
+            row = _Log_Entry_Renderer_->RenderLogEntryWithSearchHighlight(entry, is_selected, relative_line_number,
+                context.highlight_term, context.highlight_case_sensitive, context.is_filter_highlight, row_id,
+                GetRowMatchSpans(view_index, context));
         } else {
-            row = _Log_Entry_Renderer_->RenderLogEntry(entry, is_selected, relative_line_number);
+            row = _Log_Entry_Renderer_->RenderLogEntry(entry, is_selected, relative_line_number, row_id);
         }
         
         // Apply additional styling for context lines and search highlighting
-        bool is_match = match_line_numbers_.find(entry.Get_line_number()) != match_line_numbers_.end();
+        bool is_match = !IsContextEntry(view_index);
         
         if (!is_match && context_lines_ > 0) {
             // This is a context line - use muted color for better visibility on light theme
@@ -2048,7 +2487,7 @@ ftxui::Element MainWindow::RenderLogEntry(const LogEntry& entry, bool is_selecte
     };
     
     // Check if this entry is a match or context line
-    bool is_match = match_line_numbers_.find(entry.Get_line_number()) != match_line_numbers_.end();
+    bool is_match = !IsContextEntry(view_index);
     
     // Build the row with separate elements for proper word wrapping
     std::vector<Element> row_elements;
@@ -2224,16 +2663,9 @@ void MainWindow::EnsureSelectionVisible() {
     // Ensure we don't scroll past the beginning
     scroll_offset_ = std::max(0, scroll_offset_);
     
-    // For the maximum offset, be more permissive to allow proper scrolling
-    // when the selection is near the end of the file
-    int max_offset = std::max(0, total_entries - 1); // Allow scrolling to show last entry
-    if (selected_entry_index_ >= total_entries - visible_height) {
-        // When near the end, allow more flexible scrolling
-        max_offset = total_entries - 1;
-    } else {
-        // Normal case: don't scroll past the point where we'd have empty space at bottom
-        max_offset = total_entries - visible_height;
-    }
+    // Don't scroll past the point where we'd have empty space at the bottom;
+    // the table renders exactly the rows from scroll_offset_, so this keeps the last page full
+    int max_offset = total_entries - visible_height;
     
     scroll_offset_ = std::min(scroll_offset_, max_offset);
 }
@@ -2241,6 +2673,11 @@ void MainWindow::EnsureSelectionVisible() {
 
 
 void MainWindow::OnFiltersChanged() {
+    // Filters may have been edited in place (toggled, cycled, removed), so recompile the plan
+    if (_Filter_Engine_) {
+        _Filter_Engine_->InvalidatePlan();
+    }
+    
     // Check if we have hierarchical filters (contextual filters) and apply those
     if (current_filter_expression_ && !current_filter_expression_->IsEmpty()) {
         ApplyCurrentFilter();
@@ -2251,55 +2688,33 @@ void MainWindow::OnFiltersChanged() {
 }
 
 void MainWindow::ApplyTraditionalFilters() {
+    PerfCounters::ScopedTimer filter_timer(perf_counters_, PerfCounters::FilterApply);
+    RestartSearchScan();
+    
     if (!_Filter_Engine_) {
-        filtered_entries_ = log_entries_;
+        ShowAllLogEntries();
         return;
     }
     
-    // Get all active filters from the filter engine
-    const auto& filters = _Filter_Engine_->Get_primary_filters();
-    std::vector<LogEntry> matches;
-    
-    // If no active filters, show all entries
-    bool has_active_filters = false;
-    for (const auto& filter : filters) {
-        if (filter->Get_is_active()) {
-            has_active_filters = true;
-            break;
-        }
-    }
+    // Active filters compiled once into an evaluation plan
+    auto plan = _Filter_Engine_->GetCompiledPlan();
     
-    if (!has_active_filters) {
+    if (plan->IsEmpty()) {
         // No active filters - show all entries or all entries with context
         if (context_lines_ == 0) {
-            filtered_entries_ = log_entries_;
+            ShowAllLogEntries();
         } else {
-            BuildContextEntries(log_entries_);
+            std::vector<size_t> match_indices(log_entries_.size());
+            std::iota(match_indices.begin(), match_indices.end(), size_t{0});
+            BuildContextEntries(match_indices);
         }
     } else {
-        // Apply active filters with AND logic
-        for (const auto& entry : log_entries_) {
-            bool entry_matches = true; // Start with true for AND logic
-            
-            // Check each active filter - entry must match ALL active filters
-            for (const auto& filter : filters) {
-                if (filter->Get_is_active() && !filter->Matches(entry)) {
-                    entry_matches = false;
-                    break; // AND logic - if any filter doesn't match, exclude the entry
-                }
-            }
-            
-            if (entry_matches) {
-                matches.push_back(entry);
-            }
-        }
+        // Apply active filters with AND logic, collecting indices into log_entries_.
+        // Cached per-filter bitmaps mean only new or edited filters are evaluated against the entries.
+        std::vector<size_t> match_indices = _Filter_Engine_->CollectMatchAllIndices(log_entries_, &category_index_, &range_index_);
         
         // Apply context lines if needed
-        if (context_lines_ == 0) {
-            filtered_entries_ = matches;
-        } else {
-            BuildContextEntries(matches);
-        }
+        BuildContextEntries(match_indices);
     }
     
     // Update selection to stay within bounds
@@ -2322,8 +2737,7 @@ void MainWindow::ShowSearch() {
     show_search_ = true;
     search_input_mode_ = true; // Start in input mode
     search_query_.clear();
-    search_results_.clear();
-    search_result_index_ = -1;
+    ResetSearchScan();
     
     // Show search prompt in status bar
     _Last_Error_ = "Search: (type to search, Enter to confirm, + to promote to filter, Esc to cancel)";
@@ -2333,58 +2747,259 @@ void MainWindow::HideSearch() {
     show_search_ = false;
     search_input_mode_ = false;
     search_query_.clear();
-    search_results_.clear();
-    search_result_index_ = -1;
+    ResetSearchScan();
     _Last_Error_.clear(); // Clear status bar message
 }
 
 void MainWindow::PerformSearch(const std::string& query) {
     search_query_ = query;
-    search_results_.clear();
     search_result_index_ = -1;
+    search_jump_pending_ = false;
     
     if (query.empty()) {
+        ResetSearchScan();
         return;
     }
     
+    // Reuse the scan started while typing; it keeps running in the background
+    if (query != search_scan_query_) {
+        StartSearchScan(query);
+    }
+    CollectSearchProgress();
+    
+    // Jump to first result if found, or as soon as the background scan finds it
+    if (!search_results_.empty()) {
+        search_result_index_ = 0;
+        SelectEntry(search_results_[0]);
+    } else if (IsSearchScanPending()) {
+        search_jump_pending_ = true;
+    }
+}
+
+void MainWindow::StartSearchScan(const std::string& query) {
+    // Keep whatever the previous scan already found; it is narrowed down below
+    search_executor_.Cancel();
+    CollectSearchProgress();
+    
     // Smart case sensitivity: case-sensitive if query contains uppercase, case-insensitive if all lowercase
-    bool case_sensitive = HasUppercaseLetters(query);
+    search_scan_matcher_ = string_search::SubstringMatcher(query, HasUppercaseLetters(query));
+    search_result_index_ = -1;
     
-    // Search through filtered entries
-    for (int i = 0; i < static_cast<int>(filtered_entries_.size()); ++i) {
-        const auto& entry = filtered_entries_[i];
-        
-        // Search in message, logger name, and log level
-        std::string search_text = entry.Get_message() + " " + entry.Get_logger_name();
-        if (entry.Get_log_level().has_value()) {
-            search_text += " " + entry.Get_log_level().value();
-        }
-        
-        bool found = false;
-        if (case_sensitive) {
-            // Case-sensitive search
-            found = search_text.find(query) != std::string::npos;
-        } else {
-            // Case-insensitive search
-            std::string lower_query = query;
-            std::string lower_text = search_text;
-            std::transform(lower_query.begin(), lower_query.end(), lower_query.begin(), ::tolower);
-            std::transform(lower_text.begin(), lower_text.end(), lower_text.begin(), ::tolower);
-            found = lower_text.find(lower_query) != std::string::npos;
+    // A query that contains the previous one can only match a subset of its entries (with either case mode),
+    // so the entries scanned so far are narrowed down instead of rescanned
+    bool can_refine = !search_scan_query_.empty() && query.find(search_scan_query_) != std::string::npos;
+    if (can_refine) {
+        // Kept results get the spans of the longer query
+        search_result_spans_.Clear();
+        std::vector<string_search::MatchSpan> spans;
+        size_t kept = 0;
+        for (int index : search_results_) {
+            spans.clear();
+            if (EntryMatchesSearch(filtered_entries_[index], spans)) {
+                search_results_[kept++] = index;
+                search_result_spans_.AddResult(spans);
+            }
         }
-        
-        if (found) {
-            search_results_.push_back(i);
+        search_results_.resize(kept);
+    } else {
+        search_results_.clear();
+        search_result_spans_.Clear();
+        search_scan_position_ = 0;
+    }
+    ++search_results_epoch_;
+    search_scan_query_ = query;
+    search_scan_started_ = std::chrono::steady_clock::now();
+    search_scan_timed_ = true;
+    
+    // A fresh scan first looks up the indexed entries, leaving only the unindexed tail to the background scan
+    if (!can_refine) {
+        if (const TrigramIndex* index = AcquireSearchIndex()) {
+            CollectIndexedSearchResults(*index);
         }
     }
     
-    // Jump to first result if found
-    if (!search_results_.empty()) {
+    LaunchSearchScan();
+}
+
+void MainWindow::LaunchSearchScan() {
+    if (search_scan_query_.empty() || search_scan_position_ >= filtered_entries_.size()) {
+        return;
+    }
+    
+    // The worker reads filtered_entries_ and search_scan_matcher_; both are only modified after
+    // search_executor_ has been cancelled
+    search_executor_.Start(search_scan_position_, filtered_entries_.size(),
+        [this](size_t index, std::vector<string_search::MatchSpan>& spans) {
+            return EntryMatchesSearch(filtered_entries_[index], spans);
+        },
+        [this]() { RequestRedraw(RedrawScheduler::Table | RedrawScheduler::StatusBar); });
+}
+
+bool MainWindow::CollectSearchProgress() {
+    if (search_scan_query_.empty()) {
+        return true;
+    }
+    
+    std::vector<size_t> new_results;
+    size_t scanned_end = search_executor_.TakeResults(new_results, &search_result_spans_);
+    for (size_t index : new_results) {
+        search_results_.push_back(static_cast<int>(index));
+    }
+    search_scan_position_ = std::max(search_scan_position_, scanned_end);
+    
+    // Entries appended while (or after) scanning are picked up by a follow-up scan
+    if (!search_executor_.IsRunning() && search_scan_position_ < filtered_entries_.size()) {
+        LaunchSearchScan();
+    }
+    
+    return !IsSearchScanPending();
+}
+
+void MainWindow::BeginFrame() {
+    // Tailed lines are appended first, so the panes they dirty are rebuilt in this frame
+    // and the search picks up the entries they add to the view
+    ApplyTailedLines();
+    frame_dirty_regions_ = redraw_scheduler_.BeginFrame();
+    
+    // Follow the real terminal size, so the virtualized table and the detail view fill the screen
+    ftxui::Dimensions terminal = ftxui::Terminal::Size();
+    if (terminal.dimx > 0 && terminal.dimy > 0 &&
+        (terminal.dimx != window_width_ || terminal.dimy != window_height_)) {
+        SetTerminalSize(terminal.dimx, terminal.dimy);
+        frame_dirty_regions_ |= RedrawScheduler::All;
+    }
+    
+    // Results collected from the background scan change the table, the search status and possibly the selection
+    bool search_active = IsSearchScanPending() || search_jump_pending_;
+    ContinuePendingSearch();
+    if (search_active) {
+        frame_dirty_regions_ |= RedrawScheduler::Table | RedrawScheduler::StatusBar | RedrawScheduler::DetailView;
+    }
+    
+    // Scrollbar density marks for rows added to the view since the last frame
+    UpdateViewHistogram();
+}
+
+void MainWindow::ContinuePendingSearch() {
+    // Called before every frame: pick up the matches the background scan published since the last frame
+    AcquireSearchIndex();
+    if (search_scan_query_.empty()) {
+        return;
+    }
+    
+    CollectSearchProgress();
+    if (search_scan_timed_ && !IsSearchScanPending()) {
+        perf_counters_.Record(PerfCounters::SearchScan, PerfCounters::MillisecondsSince(search_scan_started_));
+        search_scan_timed_ = false;
+    }
+    
+    // FindNext/FindPrevious work on the partial results; a confirmed search jumps to its first match
+    if (search_jump_pending_ && !search_results_.empty()) {
+        search_jump_pending_ = false;
         search_result_index_ = 0;
         SelectEntry(search_results_[0]);
     }
 }
 
+bool MainWindow::IsSearchScanPending() const {
+    return !search_scan_query_.empty() && search_scan_position_ < filtered_entries_.size();
+}
+
+void MainWindow::ResetSearchScan() {
+    search_executor_.Cancel();
+    std::vector<size_t> discarded;
+    search_executor_.TakeResults(discarded);
+    
+    search_scan_query_.clear();
+    search_scan_matcher_ = string_search::SubstringMatcher();
+    search_scan_position_ = 0;
+    search_results_.clear();
+    search_result_spans_.Clear();
+    ++search_results_epoch_;
+    search_result_index_ = -1;
+    search_jump_pending_ = false;
+    search_scan_timed_ = false;
+}
+
+void MainWindow::RestartSearchScan() {
+    // filtered_entries_ is about to be rebuilt, so the old result indices are meaningless;
+    // the same query is scanned again from the start on the next frame
+    search_executor_.Cancel();
+    std::vector<size_t> discarded;
+    search_executor_.TakeResults(discarded);
+    
+    search_results_.clear();
+    search_result_spans_.Clear();
+    ++search_results_epoch_;
+    search_result_index_ = -1;
+    search_scan_position_ = 0;
+    search_scan_started_ = std::chrono::steady_clock::now();
+    search_scan_timed_ = !search_scan_query_.empty();
+}
+
+bool MainWindow::EntryMatchesSearch(const LogEntry& entry, std::vector<string_search::MatchSpan>& spans) const {
+    // Message, logger name, and log level are searched in place; the message matches are kept for highlighting
+    return search_scan_matcher_.FindAll(entry.Get_message(), spans) > 0 ||
+           search_scan_matcher_.Matches(entry.Get_logger_name()) ||
+           (entry.Get_log_level().has_value() && search_scan_matcher_.Matches(entry.Get_log_level().value()));
+}
+
+void MainWindow::CollectIndexedSearchResults(const TrigramIndex& index) {
+    std::vector<uint32_t> candidates;
+    if (!index.FindCandidates(search_scan_query_, candidates)) {
+        return; // Query shorter than a trigram
+    }
+    
+    // Rows [0, indexed_rows) show indexed entries; the rows after them are left to the background scan
+    auto indexed_end = std::lower_bound(filtered_log_indices_.begin(), filtered_log_indices_.end(),
+                                        index.GetEntryCount());
+    
+    // An unselective query gains little from random access, and the progressive scan shows results sooner
+    if (candidates.size() > static_cast<size_t>(indexed_end - filtered_log_indices_.begin()) / 4) {
+        return;
+    }
+    
+    // Candidates are sorted, so each lookup continues from the previous row and results stay in view order
+    auto row = filtered_log_indices_.begin();
+    std::vector<string_search::MatchSpan> spans;
+    for (uint32_t candidate : candidates) {
+        row = std::lower_bound(row, indexed_end, static_cast<size_t>(candidate));
+        if (row == indexed_end) {
+            break;
+        }
+        size_t position = static_cast<size_t>(row - filtered_log_indices_.begin());
+        spans.clear();
+        if (*row == candidate && EntryMatchesSearch(filtered_entries_[position], spans)) {
+            search_results_.push_back(static_cast<int>(position));
+            search_result_spans_.AddResult(spans);
+        }
+    }
+    search_scan_position_ = static_cast<size_t>(indexed_end - filtered_log_indices_.begin());
+}
+
+void MainWindow::StartSearchIndexBuild() {
+    if (!search_index_enabled_ || log_entries_.size() < kMinIndexedEntries) {
+        return;
+    }
+    
+    // Builds over the current entries; log_entries_ is only modified after the builder is cancelled,
+    // and both happen on the UI thread
+    search_index_builder_.Start(log_entries_);
+}
+
+void MainWindow::ResetSearchIndex() {
+    search_index_builder_.Cancel();
+    search_index_builder_.TakeIndex();
+    search_index_.reset();
+}
+
+const TrigramIndex* MainWindow::AcquireSearchIndex() {
+    if (auto finished = search_index_builder_.TakeIndex()) {
+        search_index_ = std::move(finished);
+    }
+    return search_index_.get();
+}
+
 void MainWindow::FindNext() {
     if (search_results_.empty()) {
         return;
@@ -2441,8 +3056,7 @@ void MainWindow::FindPrevious() {
 
 void MainWindow::ClearSearch() {
     search_query_.clear();
-    search_results_.clear();
-    search_result_index_ = -1;
+    ResetSearchScan();
 }
 
 // Search input handling implementations
@@ -2456,7 +3070,9 @@ void MainWindow::AppendToSearch(const std::string& text) {
 void MainWindow::ConfirmSearch() {
     if (!search_query_.empty()) {
         PerformSearch(search_query_);
-        if (!search_results_.empty()) {
+        if (IsSearchScanPending()) {
+            _Last_Error_ = "Searching for '" + search_query_ + "'... Use n/N to navigate the matches found so far.";
+        } else if (!search_results_.empty()) {
             _Last_Error_ = "Found " + std::to_string(search_results_.size()) + " matches for '" + search_query_ + "'. Use n/N to navigate.";
         } else {
             _Last_Error_ = "No matches found for '" + search_query_ + "'";
@@ -2471,8 +3087,7 @@ void MainWindow::BackspaceSearch() {
         search_query_.pop_back();
         if (search_query_.empty()) {
             _Last_Error_ = "Search: (type to search, Enter to confirm, + to promote, Esc to cancel)";
-            search_results_.clear();
-            search_result_index_ = -1;
+            ResetSearchScan();
         } else {
             _Last_Error_ = "Search: " + search_query_ + " (Enter to confirm, + to promote, Esc to cancel)";
             // Perform search for highlighting but don't jump to results while typing
@@ -2563,7 +3178,7 @@ void MainWindow::FindNextInlineMatch() {
     current_inline_match_ = (current_inline_match_ + 1) % inline_search_matches_.size();
     _Last_Error_ = "In-line match " + std::to_string(current_inline_match_ + 1) + 
                  " of " + std::to_string(inline_search_matches_.size()) + 
-                 " (position " + std::to_string(inline_search_matches_[current_inline_match_]) + ")";
+                 " (position " + std::to_string(inline_search_matches_[current_inline_match_].offset) + ")";
 }
 
 void MainWindow::FindPreviousInlineMatch() {
@@ -2579,7 +3194,7 @@ void MainWindow::FindPreviousInlineMatch() {
     
     _Last_Error_ = "In-line match " + std::to_string(current_inline_match_ + 1) + 
                  " of " + std::to_string(inline_search_matches_.size()) + 
-                 " (position " + std::to_string(inline_search_matches_[current_inline_match_]) + ")";
+                 " (position " + std::to_string(inline_search_matches_[current_inline_match_].offset) + ")";
 }
 
 void MainWindow::UpdateInlineSearchResults() {
@@ -2597,20 +3212,9 @@ void MainWindow::UpdateInlineSearchResults() {
     // Smart case sensitivity: case-sensitive if query contains uppercase, case-insensitive if all lowercase
     bool case_sensitive = HasUppercaseLetters(inline_search_query_);
     
-    std::string search_text = line_text;
-    std::string search_query = inline_search_query_;
-    
-    if (!case_sensitive) {
-        std::transform(search_text.begin(), search_text.end(), search_text.begin(), ::tolower);
-        std::transform(search_query.begin(), search_query.end(), search_query.begin(), ::tolower);
-    }
-    
-    // Find all occurrences
-    size_t pos = 0;
-    while ((pos = search_text.find(search_query, pos)) != std::string::npos) {
-        inline_search_matches_.push_back(pos);
-        pos += search_query.length();
-    }
+    // Find all occurrences once; highlighting slices the line by these spans
+    string_search::SubstringMatcher matcher(inline_search_query_, case_sensitive);
+    matcher.FindAll(line_text, inline_search_matches_);
 }
 
 // Jump functionality implementations
@@ -2845,7 +3449,15 @@ void MainWindow::BackspaceVimCommand() {
 
 void MainWindow::CreateSampleLogEntries() {
     // Create sample log entries that represent typical Unreal Engine log output
+    ResetSearchIndex();
+    if (_Log_Entry_Renderer_) {
+        _Log_Entry_Renderer_->ClearRowCache();
+    }
+    detail_layouts_.Clear();
     log_entries_.clear();
+    if (_Filter_Engine_) {
+        _Filter_Engine_->ResetMatchBitmaps();
+    }
     
     // Sample entries with different log levels and formats
     log_entries_.emplace_back(
@@ -2977,6 +3589,9 @@ void MainWindow::CreateSampleLogEntries() {
             i
         );
     }
+    
+    category_index_.Rebuild(log_entries_);
+    range_index_.Rebuild(log_entries_);
 }
 
 void MainWindow::CreateSampleFilters() {
@@ -3211,33 +3826,32 @@ ftxui::Element MainWindow::CreateHighlightedMessageElement(const std::string& me
     std::vector<Element> elements;
     size_t last_pos = 0;
     
-    // Create highlighted segments
-    for (size_t match_pos : inline_search_matches_) {
-        // Add text before the match
-        if (match_pos > last_pos) {
-            std::string before_match = message.substr(last_pos, match_pos - last_pos);
-            elements.push_back(text(before_match));
+    // Slice the message by the recorded spans; spans past its end are ignored
+    for (size_t i = 0; i < inline_search_matches_.size(); ++i) {
+        const string_search::MatchSpan& match = inline_search_matches_[i];
+        if (match.offset < last_pos || match.offset >= message.length()) {
+            continue;
         }
         
-        // Add highlighted match
-        std::string match_text = message.substr(match_pos, inline_search_query_.length());
-        Element highlighted_match = text(match_text) | bgcolor(Color::YellowLight) | color(Color::Black);
+        // Add text before the match
+        if (match.offset > last_pos) {
+            elements.push_back(text(message.substr(last_pos, match.offset - last_pos)));
+        }
         
-        // If this is the current match, make it even more prominent
-        if (!inline_search_matches_.empty() && 
-            current_inline_match_ < inline_search_matches_.size() && 
-            match_pos == inline_search_matches_[current_inline_match_]) {
-            highlighted_match = highlighted_match | bold | bgcolor(Color::YellowLight);
+        // Add highlighted match; the current match is made even more prominent
+        Element highlighted_match = text(message.substr(match.offset, match.length)) |
+                                    bgcolor(Color::YellowLight) | color(Color::Black);
+        if (i == current_inline_match_) {
+            highlighted_match = highlighted_match | bold;
         }
         
         elements.push_back(highlighted_match);
-        last_pos = match_pos + inline_search_query_.length();
+        last_pos = std::min<size_t>(match.offset + match.length, message.length());
     }
     
     // Add remaining text after the last match
     if (last_pos < message.length()) {
-        std::string after_matches = message.substr(last_pos);
-        elements.push_back(text(after_matches));
+        elements.push_back(text(message.substr(last_pos)));
     }
     
     return hbox(elements);
@@ -3254,6 +3868,14 @@ ftxui::Element MainWindow::RenderSearchStatusBar() const {
         if (search_input_mode_) {
             // Currently typing search
             search_text = "Search: " + search_query_ + " (Enter to confirm, + to promote, Esc to cancel)";
+            if (IsSearchScanPending()) {
+                search_text += " - " + std::to_string(search_results_.size()) + " matches so far";
+            }
+            bg_color = Color::Blue;
+        } else if (IsSearchScanPending()) {
+            // Background scan still running; partial results can already be navigated
+            search_text = "Searching '" + search_query_ + "': " + std::to_string(search_results_.size()) +
+                          " matches so far (n/N to navigate, Esc to exit)";
             bg_color = Color::Blue;
         } else {
             // Search completed, showing results
@@ -3291,30 +3913,78 @@ ftxui::Element MainWindow::RenderSearchStatusBar() const {
 
 // Helper method to apply the current filter expression
 void MainWindow::ApplyCurrentFilter() {
+    PerfCounters::ScopedTimer filter_timer(perf_counters_, PerfCounters::FilterApply);
+    RestartSearchScan();
+    
     if (!current_filter_expression_ || current_filter_expression_->IsEmpty()) {
         // No filter - show all entries
         if (context_lines_ == 0) {
-            filtered_entries_ = log_entries_;
+            ShowAllLogEntries();
         } else {
-            BuildContextEntries(log_entries_);
+            std::vector<size_t> match_indices(log_entries_.size());
+            std::iota(match_indices.begin(), match_indices.end(), size_t{0});
+            BuildContextEntries(match_indices);
         }
         return;
     }
     
-    // Apply filter expression
-    std::vector<LogEntry> matches;
-    for (const auto& entry : log_entries_) {
-        if (current_filter_expression_->Matches(entry)) {
-            matches.push_back(entry);
+    // Apply filter expression on all cores, collecting indices into log_entries_.
+    // The tree is flattened and reordered once so cheap, decisive conditions run first.
+    const FilterExpression& expression = *current_filter_expression_;
+    ExpressionPlan plan(expression, log_entries_);
+    std::vector<size_t> match_indices;
+    
+    // Line and frame conditions restrict evaluation to runs of entries found by binary search
+    std::vector<EntryInterval> intervals;
+    bool ranged = range_index_.Get_entry_count() == log_entries_.size() &&
+                  expression.CollectIntervals(range_index_, log_entries_, intervals);
+    if (!ranged) {
+        intervals.assign(1, EntryInterval{0, log_entries_.size()});
+    }
+    
+    std::vector<uint32_t> candidates;
+    size_t indexed_count = 0;
+    CandidateIndexes indexes;
+    indexes.trigrams = AcquireSearchIndex();
+    indexes.categories = &category_index_;
+    if (expression.CollectCandidates(indexes, candidates, indexed_count)) {
+        // Text, logger and level conditions narrowed the indexed entries down to candidates;
+        // only those inside the ranges and the entries past the indexed prefix are evaluated
+        if (ranged) {
+            size_t run = 0;
+            candidates.erase(std::remove_if(candidates.begin(), candidates.end(), [&intervals, &run](uint32_t id) {
+                while (run < intervals.size() && intervals[run].end <= id) {
+                    ++run;
+                }
+                return run == intervals.size() || id < intervals[run].begin;
+            }), candidates.end());
+        }
+        std::vector<size_t> hits = parallel::CollectMatchingIndices(candidates.size(),
+            [this, &plan, &candidates](size_t i) { return plan.Matches(log_entries_[candidates[i]]); });
+        match_indices.reserve(hits.size());
+        for (size_t i : hits) {
+            match_indices.push_back(candidates[i]);
+        }
+        for (const EntryInterval& interval : intervals) {
+            for (size_t i = std::max(interval.begin, indexed_count); i < interval.end; ++i) {
+                if (plan.Matches(log_entries_[i])) {
+                    match_indices.push_back(i);
+                }
+            }
         }
-    }
-    
-    if (context_lines_ == 0) {
-        filtered_entries_ = matches;
     } else {
-        BuildContextEntries(matches);
+        for (const EntryInterval& interval : intervals) {
+            size_t begin = interval.begin;
+            std::vector<size_t> hits = parallel::CollectMatchingIndices(interval.end - begin,
+                [this, &plan, begin](size_t i) { return plan.Matches(log_entries_[begin + i]); });
+            for (size_t i : hits) {
+                match_indices.push_back(begin + i);
+            }
+        }
     }
     
+    BuildContextEntries(match_indices);
+    
     // Update selection
     if (selected_entry_index_ >= static_cast<int>(filtered_entries_.size())) {
         selected_entry_index_ = filtered_entries_.empty() ? -1 : static_cast<int>(filtered_entries_.size()) - 1;
@@ -3322,58 +3992,41 @@ void MainWindow::ApplyCurrentFilter() {
     EnsureSelectionVisible();
 }
 
-// Helper method to build context entries around matches
-void MainWindow::BuildContextEntries(const std::vector<LogEntry>& matches) {
-    if (matches.empty() || context_lines_ == 0) {
-        filtered_entries_ = matches;
-        // Clear match tracking since all entries are matches
-        match_line_numbers_.clear();
-        for (const auto& match : matches) {
-            match_line_numbers_.insert(match.Get_line_number());
-        }
-        return;
-    }
-    
-    std::vector<LogEntry> result;
-    std::set<size_t> included_indices;
-    match_line_numbers_.clear();
-    
-    // Track which line numbers are actual matches
-    for (const auto& match : matches) {
-        match_line_numbers_.insert(match.Get_line_number());
-    }
+// Helper method to show every log entry unfiltered
+void MainWindow::ShowAllLogEntries() {
+    filtered_entries_ = log_entries_;
+    filtered_log_indices_.resize(log_entries_.size());
+    std::iota(filtered_log_indices_.begin(), filtered_log_indices_.end(), size_t{0});
+    ResetFilteredLevelRows();
+}
+
+// Helper method to build filtered_entries_ from sorted match indices, with context lines around them
+void MainWindow::BuildContextEntries(const std::vector<size_t>& match_indices) {
+    filtered_entries_.clear();
+    filtered_log_indices_.clear();
+    ResetFilteredLevelRows();
+    context_ranges_.clear();
+    context_match_flags_.clear();
+    context_pending_end_ = 0;
     
-    // For each match, include context lines
-    for (const auto& match : matches) {
-        // Find the match in the original log entries
-        auto it = std::find_if(log_entries_.begin(), log_entries_.end(),
-            [&match](const LogEntry& entry) {
-                return entry.Get_line_number() == match.Get_line_number();
-            });
-        
-        if (it != log_entries_.end()) {
-            size_t match_index = std::distance(log_entries_.begin(), it);
-            
-            // Include context before
-            size_t start_index = (match_index >= static_cast<size_t>(context_lines_)) ? 
-                                match_index - context_lines_ : 0;
-            
-            // Include context after
-            size_t end_index = std::min(match_index + context_lines_ + 1, log_entries_.size());
-            
-            // Add all entries in the range
-            for (size_t i = start_index; i < end_index; ++i) {
-                included_indices.insert(i);
-            }
+    if (context_lines_ == 0) {
+        filtered_entries_.reserve(match_indices.size());
+        for (size_t index : match_indices) {
+            filtered_entries_.push_back(log_entries_[index]);
         }
+        filtered_log_indices_ = match_indices;
+        return;
     }
     
-    // Build the result vector in order
-    for (size_t index : included_indices) {
-        result.push_back(log_entries_[index]);
+    // Single sweep over the sorted matches: each match extends or starts a run,
+    // and overlapping context is merged by AppendContextRange
+    size_t context = static_cast<size_t>(context_lines_);
+    for (size_t match_index : match_indices) {
+        size_t start_index = (match_index >= context) ? match_index - context : 0;
+        AppendContextRange(start_index, match_index + context + 1);
+        MarkContextMatch(match_index);
+        context_pending_end_ = match_index + context + 1;
     }
-    
-    filtered_entries_ = result;
 }
 
 // Quick filter functionality implementations
@@ -3429,127 +4082,136 @@ void MainWindow::ApplyQuickFilter(const std::string& filter_type) {
 
 // Pattern-based navigation implementations
 void MainWindow::JumpToNextError() {
+    JumpToLevel("Error", "error", true);
+}
+
+void MainWindow::JumpToPreviousError() {
+    JumpToLevel("Error", "error", false);
+}
+
+void MainWindow::JumpToNextWarning() {
+    JumpToLevel("Warning", "warning", true);
+}
+
+void MainWindow::JumpToPreviousWarning() {
+    JumpToLevel("Warning", "warning", false);
+}
+
+void MainWindow::JumpToLevel(const std::string& level, const std::string& label, bool forward) {
     if (filtered_entries_.empty()) {
         _Last_Error_ = "No entries to search";
         return;
     }
     
-    // Start searching from the next entry after current selection
-    int start_index = selected_entry_index_ + 1;
-    
-    for (int i = start_index; i < static_cast<int>(filtered_entries_.size()); ++i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Error") {
-            SelectEntry(i);
-            _Last_Error_ = "Jumped to next error at line " + std::to_string(i + 1);
-            return;
-        }
+    bool wrapped = false;
+    int row = FindLevelRow(level, forward, wrapped);
+    if (row < 0) {
+        _Last_Error_ = "No " + label + " entries found";
+        return;
     }
     
-    // If not found, wrap around to beginning
-    for (int i = 0; i < start_index && i < static_cast<int>(filtered_entries_.size()); ++i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Error") {
-            SelectEntry(i);
-            _Last_Error_ = "Wrapped to first error at line " + std::to_string(i + 1);
-            return;
-        }
+    SelectEntry(row);
+    if (wrapped) {
+        _Last_Error_ = std::string(forward ? "Wrapped to first " : "Wrapped to last ") + label +
+                       " at line " + std::to_string(row + 1);
+    } else {
+        _Last_Error_ = std::string(forward ? "Jumped to next " : "Jumped to previous ") + label +
+                       " at line " + std::to_string(row + 1);
     }
-    
-    _Last_Error_ = "No error entries found";
 }
 
-void MainWindow::JumpToPreviousError() {
-    if (filtered_entries_.empty()) {
-        _Last_Error_ = "No entries to search";
-        return;
+int MainWindow::FindLevelRow(const std::string& level, bool forward, bool& wrapped) {
+    wrapped = false;
+    uint32_t level_id = category_index_.FindLevelId(level);
+    if (level_id == LogCategoryIndex::kInvalidId) {
+        return -1;
     }
     
-    // Start searching from the previous entry before current selection
-    int start_index = selected_entry_index_ - 1;
-    
-    for (int i = start_index; i >= 0; --i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Error") {
-            SelectEntry(i);
-            _Last_Error_ = "Jumped to previous error at line " + std::to_string(i + 1);
-            return;
-        }
+    UpdateFilteredLevelRows();
+    if (level_id >= filtered_level_rows_.size() || filtered_level_rows_[level_id].empty()) {
+        return -1;
     }
     
-    // If not found, wrap around to end
-    for (int i = static_cast<int>(filtered_entries_.size()) - 1; i > start_index; --i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Error") {
-            SelectEntry(i);
-            _Last_Error_ = "Wrapped to last error at line " + std::to_string(i + 1);
-            return;
+    // Binary search around the selection; wrapping around is just the other end of the list
+    const std::vector<int>& rows = filtered_level_rows_[level_id];
+    if (forward) {
+        auto it = std::upper_bound(rows.begin(), rows.end(), selected_entry_index_);
+        if (it != rows.end()) {
+            return *it;
         }
+        wrapped = true;
+        return rows.front();
     }
     
-    _Last_Error_ = "No error entries found";
+    auto it = std::lower_bound(rows.begin(), rows.end(), selected_entry_index_);
+    if (it != rows.begin()) {
+        return *(it - 1);
+    }
+    wrapped = true;
+    return rows.back();
 }
 
-void MainWindow::JumpToNextWarning() {
-    if (filtered_entries_.empty()) {
-        _Last_Error_ = "No entries to search";
-        return;
-    }
-    
-    // Start searching from the next entry after current selection
-    int start_index = selected_entry_index_ + 1;
-    
-    for (int i = start_index; i < static_cast<int>(filtered_entries_.size()); ++i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Warning") {
-            SelectEntry(i);
-            _Last_Error_ = "Jumped to next warning at line " + std::to_string(i + 1);
-            return;
+void MainWindow::UpdateFilteredLevelRows() {
+    // The view only grows at its tail between rebuilds, so rows are appended in order
+    for (size_t row = filtered_level_rows_end_; row < filtered_log_indices_.size(); ++row) {
+        uint32_t level_id = category_index_.GetEntryLevelId(filtered_log_indices_[row]);
+        if (level_id == LogCategoryIndex::kInvalidId) {
+            continue;
         }
-    }
-    
-    // If not found, wrap around to beginning
-    for (int i = 0; i < start_index && i < static_cast<int>(filtered_entries_.size()); ++i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Warning") {
-            SelectEntry(i);
-            _Last_Error_ = "Wrapped to first warning at line " + std::to_string(i + 1);
-            return;
+        if (level_id >= filtered_level_rows_.size()) {
+            filtered_level_rows_.resize(level_id + 1);
         }
+        filtered_level_rows_[level_id].push_back(static_cast<int>(row));
     }
-    
-    _Last_Error_ = "No warning entries found";
+    filtered_level_rows_end_ = filtered_log_indices_.size();
 }
 
-void MainWindow::JumpToPreviousWarning() {
-    if (filtered_entries_.empty()) {
-        _Last_Error_ = "No entries to search";
-        return;
+void MainWindow::ResetFilteredLevelRows() {
+    filtered_level_rows_.clear();
+    filtered_level_rows_end_ = 0;
+    view_histogram_.Clear();
+}
+
+void MainWindow::UpdateViewHistogram() {
+    if (view_histogram_.GetRowCount() > filtered_log_indices_.size()) {
+        view_histogram_.Clear();
     }
-    
-    // Start searching from the previous entry before current selection
-    int start_index = selected_entry_index_ - 1;
-    
-    for (int i = start_index; i >= 0; --i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Warning") {
-            SelectEntry(i);
-            _Last_Error_ = "Jumped to previous warning at line " + std::to_string(i + 1);
-            return;
-        }
+    if (view_histogram_.GetRowCount() == 0) {
+        histogram_search_results_ = 0; // Search hits are counted again once their rows are back
     }
     
-    // If not found, wrap around to end
-    for (int i = static_cast<int>(filtered_entries_.size()) - 1; i > start_index; --i) {
-        const auto& entry = filtered_entries_[i];
-        if (entry.Get_log_level().has_value() && entry.Get_log_level().value() == "Warning") {
-            SelectEntry(i);
-            _Last_Error_ = "Wrapped to last warning at line " + std::to_string(i + 1);
-            return;
-        }
+    // Like the level rows, the histogram only needs the rows appended since the last frame;
+    // a freshly loaded or refiltered view is counted on all cores
+    if (view_histogram_.GetRowCount() < filtered_log_indices_.size()) {
+        uint32_t error_id = category_index_.FindLevelId("Error");
+        uint32_t warning_id = category_index_.FindLevelId("Warning");
+        bool view_is_filtered = (current_filter_expression_ && !current_filter_expression_->IsEmpty()) ||
+                                (_Filter_Engine_ && _Filter_Engine_->GetTotalActiveFilters() > 0);
+        
+        view_histogram_.AppendRows(filtered_log_indices_.size() - view_histogram_.GetRowCount(), [&](size_t row) {
+            uint32_t level_id = category_index_.GetEntryLevelId(filtered_log_indices_[row]);
+            uint32_t series_mask = 0;
+            if (level_id == error_id && error_id != LogCategoryIndex::kInvalidId) {
+                series_mask |= 1u << ErrorSeries;
+            } else if (level_id == warning_id && warning_id != LogCategoryIndex::kInvalidId) {
+                series_mask |= 1u << WarningSeries;
+            }
+            if (view_is_filtered && !IsContextEntry(row)) {
+                series_mask |= 1u << FilterMatchSeries;
+            }
+            return series_mask;
+        });
     }
     
-    _Last_Error_ = "No warning entries found";
+    // Search hits arrive after their rows, in row order; a new or narrowed result list is counted from scratch
+    if (histogram_search_epoch_ != search_results_epoch_ || histogram_search_results_ > search_results_.size()) {
+        view_histogram_.ClearSeries(SearchHitSeries);
+        histogram_search_results_ = 0;
+        histogram_search_epoch_ = search_results_epoch_;
+    }
+    for (; histogram_search_results_ < search_results_.size(); ++histogram_search_results_) {
+        view_histogram_.AddToRow(SearchHitSeries, static_cast<size_t>(search_results_[histogram_search_results_]));
+    }
 }
 
 void MainWindow::CreateLineNumberFilter(const LogEntry& entry) {
@@ -3889,21 +4551,10 @@ void MainWindow::DetailViewScrollUp(int count) {
 void MainWindow::DetailViewScrollDown(int count) {
     if (!detail_view_focused_) return;
     
-    // Get the current entry to calculate max scroll
-    if (selected_entry_index_ >= 0 && selected_entry_index_ < static_cast<int>(filtered_entries_.size())) {
-        const auto& selected_entry = filtered_entries_[selected_entry_index_];
-        std::string full_message = selected_entry.Get_message();
-        
-        // Count lines in the message
-        int line_count = 1;
-        for (char c : full_message) {
-            if (c == '\n') line_count++;
-        }
-        
-        int available_height = (window_height_ > 0) ? window_height_ : 30; // Fallback to 30 lines
-        int content_height = available_height - 2; // Exclude status bars
-        int visible_height = std::max(10, (content_height * 2) / 3 - 4); // 2/3 of screen, account for window borders
-        int max_scroll = std::max(0, line_count - visible_height);
+    // The max scroll comes from the wrapped line count, so the last page is full
+    if (const WrapLayout* layout = GetDetailViewLayout()) {
+        int line_count = static_cast<int>(layout->GetLineCount());
+        int max_scroll = std::max(0, line_count - GetDetailViewVisibleHeight());
         
         detail_view_scroll_offset_ = std::min(max_scroll, detail_view_scroll_offset_ + count);
     }
@@ -3954,21 +4605,9 @@ void MainWindow::DetailViewScrollToTop() {
 void MainWindow::DetailViewScrollToBottom() {
     if (!detail_view_focused_) return;
     
-    // Get the current entry to calculate max scroll
-    if (selected_entry_index_ >= 0 && selected_entry_index_ < static_cast<int>(filtered_entries_.size())) {
-        const auto& selected_entry = filtered_entries_[selected_entry_index_];
-        std::string full_message = selected_entry.Get_message();
-        
-        // Count lines in the message
-        int line_count = 1;
-        for (char c : full_message) {
-            if (c == '\n') line_count++;
-        }
-        
-        int available_height = (window_height_ > 0) ? window_height_ : 30; // Fallback to 30 lines
-        int content_height = available_height - 2; // Exclude status bars
-        int visible_height = std::max(10, (content_height * 2) / 3 - 4); // 2/3 of screen, account for window borders
-        detail_view_scroll_offset_ = std::max(0, line_count - visible_height);
+    if (const WrapLayout* layout = GetDetailViewLayout()) {
+        int line_count = static_cast<int>(layout->GetLineCount());
+        detail_view_scroll_offset_ = std::max(0, line_count - GetDetailViewVisibleHeight());
     }
 }
 
@@ -4077,43 +4716,16 @@ void MainWindow::CreateDirectColumnExcludeFilter(int column_number) {
 
 void MainWindow::PerformSearchHighlightOnly(const std::string& query) {
     search_query_ = query;
-    search_results_.clear();
     search_result_index_ = -1;
     
     if (query.empty()) {
+        ResetSearchScan();
         return;
     }
     
-    // Smart case sensitivity: case-sensitive if query contains uppercase, case-insensitive if all lowercase
-    bool case_sensitive = HasUppercaseLetters(query);
-    
-    // Search through filtered entries
-    for (int i = 0; i < static_cast<int>(filtered_entries_.size()); ++i) {
-        const auto& entry = filtered_entries_[i];
-        
-        // Search in message, logger name, and log level
-        std::string search_text = entry.Get_message() + " " + entry.Get_logger_name();
-        if (entry.Get_log_level().has_value()) {
-            search_text += " " + entry.Get_log_level().value();
-        }
-        
-        bool found = false;
-        if (case_sensitive) {
-            // Case-sensitive search
-            found = search_text.find(query) != std::string::npos;
-        } else {
-            // Case-insensitive search
-            std::string lower_query = query;
-            std::string lower_text = search_text;
-            std::transform(lower_query.begin(), lower_query.end(), lower_query.begin(), ::tolower);
-            std::transform(lower_text.begin(), lower_text.end(), lower_text.begin(), ::tolower);
-            found = lower_text.find(lower_query) != std::string::npos;
-        }
-        
-        if (found) {
-            search_results_.push_back(i);
-        }
-    }
+    // Narrow or restart the scan; it continues in the background and is cancelled
+    // as soon as the query changes again
+    StartSearchScan(query);
     
     // Don't jump to first result - just highlight for now
     // The user will press Enter to jump to the first result
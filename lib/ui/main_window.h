@@ -11,13 +11,21 @@
 #include "../filter_engine/filter_expression.h"
 #include "../file_monitor/file_monitor.h"
 #include "../config/config_manager.h"
+#include "../core/search_executor.h"
+#include "../core/trigram_index.h"
+#include "../core/redraw_scheduler.h"
+#include "../core/density_histogram.h"
+#include "../core/wrap_layout.h"
+#include "../core/perf_counters.h"
+#include "../common/string_search.h"
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <functional>
 #include <ftxui/component/component.hpp>
 #include <ftxui/component/screen_interactive.hpp>
 #include <ftxui/dom/elements.hpp>
-#include <set>
 
 namespace ue_log
 {
@@ -280,7 +288,7 @@ namespace ue_log
                 -> void;
         auto
             ApplyContextToNewEntries(
-                const std::vector<LogEntry>& new_entries)
+                const std::vector<size_t>& new_match_indices)
                 -> void;
         auto
             GoToTop()
@@ -403,6 +411,94 @@ namespace ue_log
                 -> void
         {
             refresh_callback_ = std::move(callback);
+            redraw_scheduler_.SetWakeCallback(refresh_callback_);
+        }
+
+        /**
+         * Cap how often background activity (tailing, search progress) redraws the screen.
+         * @param fps Maximum redraws per second; input events always redraw immediately.
+         */
+        auto
+            SetMaxRedrawFps(
+                int fps)
+                -> void
+        {
+            redraw_scheduler_.SetMaxFps(fps);
+        }
+
+        /**
+         * Mark panes as needing a redraw and wake the UI loop, rate limited to the maximum redraw FPS.
+         * Safe to call from any thread.
+         * @param regions Bitwise OR of RedrawScheduler::Region values.
+         */
+        auto
+            RequestRedraw(
+                uint32_t regions)
+                -> void
+        {
+            redraw_scheduler_.RequestRedraw(regions);
+        }
+
+        /**
+         * Prepare state for the next Render(): applies tailed lines, picks up terminal resizes and background
+         * search results, and takes the set of panes that need rebuilding. Called once before every frame.
+         */
+        auto
+            BeginFrame()
+                -> void;
+
+        /**
+         * Show or hide the performance HUD: rolling p50/p99 of frame build, input handling, filter,
+         * search and live-tail ingest timings.
+         */
+        auto
+            TogglePerfHud()
+                -> void;
+
+        auto
+            IsPerfHudVisible() const
+                -> bool
+        {
+            return show_perf_hud_;
+        }
+
+        auto
+            GetPerfCounters()
+                -> PerfCounters&
+        {
+            return perf_counters_;
+        }
+
+        /**
+         * Set the file the performance counters are written to by WritePerfCounters (for headless runs).
+         * @param file_path Output file; empty disables writing.
+         */
+        auto
+            SetPerfCountersFile(
+                const std::string& file_path)
+                -> void
+        {
+            perf_counters_file_ = file_path;
+        }
+
+        /**
+         * Write the performance counters to the file set by SetPerfCountersFile, if any.
+         * @return Success, or an error if the file cannot be written.
+         */
+        auto
+            WritePerfCounters() const
+                -> Result;
+
+        /**
+         * Enable or disable the trigram search index built in the background after a file is loaded.
+         * @param enabled Whether large logs are indexed (takes effect on the next load).
+         */
+        auto
+            SetSearchIndexEnabled(
+                bool enabled)
+                -> void
+        {
+            search_index_enabled_ = enabled;
         }
 
         /**
@@ -759,6 +855,30 @@ namespace ue_log
             return word_wrap_enabled_;
         }
 
+        /**
+         * Show or hide the minimap: per-region density of errors, warnings, filter matches and search hits
+         * across the whole view, drawn beside the scrollbar.
+         */
+        auto
+            ToggleMinimap()
+                -> void;
+
+        auto
+            IsMinimapVisible() const
+                -> bool
+        {
+            return show_minimap_;
+        }
+
+        /**
+         * Select the first row of the part of the view a minimap cell covers.
+         * @param cell Minimap cell, 0 at the top.
+         */
+        auto
+            JumpToMinimapCell(
+                int cell)
+                -> void;
+
         auto
             IsDetailViewVisible() const
                 -> bool
@@ -902,6 +1022,16 @@ namespace ue_log
                 -> std::string;
 
     private:
+        // Row categories counted per bucket of the filtered view
+        enum HistogramSeries : size_t
+        {
+            ErrorSeries,
+            WarningSeries,
+            FilterMatchSeries, // Rows matching the active filters (not context lines); empty when nothing is filtered
+            SearchHitSeries,
+            kHistogramSeriesCount
+        };
+
         // FTXUI component
         ftxui::Component _Component_;
 
@@ -929,6 +1059,14 @@ namespace ue_log
         std::string _Last_Error_;
         std::vector<LogEntry> log_entries_;
         std::vector<LogEntry> filtered_entries_;
+        std::vector<size_t> filtered_log_indices_; // log_entries_ index of each filtered_entries_ row (ascending)
+        LogCategoryIndex category_index_; // Logger/level posting lists over log_entries_, kept in sync with it
+        EntryRangeIndex range_index_; // Line/frame range lookups over log_entries_, kept in sync with it
+        std::vector<std::vector<int>> filtered_level_rows_; // Level id -> ascending filtered_entries_ rows with that level
+        size_t filtered_level_rows_end_ = 0; // Rows [0, end) are in filtered_level_rows_; later rows are added on demand
+        DensityHistogram view_histogram_{kHistogramSeriesCount}; // Category density of filtered_entries_, drawn on the scrollbar and minimap
+        size_t histogram_search_results_ = 0; // Leading search_results_ already counted in view_histogram_
+        uint64_t histogram_search_epoch_ = 0; // search_results_epoch_ those were counted under
         int selected_entry_index_ = -1;
         int scroll_offset_ = 0;
         bool show_line_numbers_ = true;
@@ -941,8 +1079,10 @@ namespace ue_log
         bool show_jump_dialog_ = false;
         bool word_wrap_enabled_ = false; // Word wrap toggle
         bool show_detail_view_ = true; // Detail view window toggle
+        bool show_minimap_ = false; // Density minimap beside the scrollbar
         bool detail_view_focused_ = false; // Whether detail view has focus
-        int detail_view_scroll_offset_ = 0; // Scroll position within detail view
+        int detail_view_scroll_offset_ = 0; // First wrapped line shown in the detail view
+        mutable WrapLayoutCache detail_layouts_{64}; // Wrapped raw lines keyed by log_entries_ index
         int window_width_ = 0;
         int window_height_ = 0;
 
@@ -950,20 +1090,37 @@ namespace ue_log
         std::string search_query_;
         int search_result_index_ = -1;
         std::vector<int> search_results_;
+        MatchSpanTable search_result_spans_; // Message spans of search_results_, in the same order
+        uint64_t search_results_epoch_ = 0; // Bumped whenever search_results_ is cleared or narrowed (not just appended to)
         bool show_search_promotion_ = false;
         bool search_input_mode_ = false; // true when typing search, false when navigating results
 
+        // Progressive search scan: search_results_ holds the matches of search_scan_query_
+        // among filtered_entries_[0, search_scan_position_); the rest is scanned by search_executor_
+        std::string search_scan_query_;
+        string_search::SubstringMatcher search_scan_matcher_;
+        size_t search_scan_position_ = 0;
+        bool search_jump_pending_ = false; // Select the first match as soon as it is found
+
         // In-line search state (CTRL+L)
         bool show_inline_search_ = false;
         bool inline_search_input_mode_ = false;
         std::string inline_search_query_;
-        std::vector<size_t> inline_search_matches_; // Character positions within the current line
+        std::vector<string_search::MatchSpan> inline_search_matches_; // Matches within the current line
         size_t current_inline_match_ = 0;
 
         // Context lines state
         int context_lines_ = 0; // Number of context lines to show around matches
         std::vector<LogEntry> context_entries_; // Filtered entries with context
-        std::set<size_t> match_line_numbers_; // Line numbers that are actual matches (not context)
+        std::vector<bool> context_match_flags_; // Bit per filtered_entries_ row: set for actual matches (not context)
+
+        // Half-open run [begin, end) of log_entries_ indices shown in filtered_entries_ when context is enabled
+        struct ContextRange {
+            size_t begin = 0;
+            size_t end = 0;
+        };
+        std::vector<ContextRange> context_ranges_; // Sorted, disjoint runs mirroring filtered_entries_
+        size_t context_pending_end_ = 0; // End of the last match's trailing context (may exceed log_entries_.size())
 
         // Contextual filter state
         bool show_contextual_filter_dialog_ = false;
@@ -998,11 +1155,77 @@ namespace ue_log
         std::function<void()> exit_callback_;
         std::function<void()> refresh_callback_;
 
+        // Background search (declared after the callbacks it uses, so it is stopped before they are destroyed)
+        SearchExecutor search_executor_;
+
+        // Frame pacing for background redraws (declared after search_executor_, whose progress it is notified of)
+        RedrawScheduler redraw_scheduler_;
+        uint32_t frame_dirty_regions_ = RedrawScheduler::All; // Panes to rebuild in the current frame
+
+        // Timing counters shown by the performance HUD
+        PerfCounters perf_counters_;
+        bool show_perf_hud_ = false;
+        std::string perf_counters_file_;
+        std::chrono::steady_clock::time_point search_scan_started_;
+        bool search_scan_timed_ = false; // A scan is running whose duration has not been recorded yet
+        std::mutex ingest_mutex_; // Guards the three below; tailed lines arrive on the file monitor thread
+        std::vector<std::string> ingest_pending_batch_; // Tailed lines not yet applied, in arrival order
+        size_t ingest_pending_lines_ = 0; // Tailed lines that arrived since the last frame
+        std::chrono::steady_clock::time_point ingest_pending_since_; // When the oldest of them arrived
+        static constexpr int kPerfHudHeight = static_cast<int>(PerfCounters::kMetricCount) + 3; // Rows, header and frame
+
+        // Panes from the last frame, reused while their region is not dirty
+        mutable ftxui::Element table_pane_;
+        mutable ftxui::Element detail_pane_;
+        mutable ftxui::Element status_pane_;
+        mutable ftxui::Element filter_panel_pane_;
+
+        // Scrollbar and minimap from the last table render and the layout they were drawn for;
+        // each is redrawn only when its layout changes
+        struct TrackLayout {
+            int track_height = -1;
+            int thumb_begin = 0;
+            int thumb_end = 0;
+            uint64_t histogram_generation = 0;
+            uint64_t theme_generation = 0;
+
+            bool operator==(const TrackLayout& other) const {
+                return track_height == other.track_height && thumb_begin == other.thumb_begin &&
+                       thumb_end == other.thumb_end && histogram_generation == other.histogram_generation &&
+                       theme_generation == other.theme_generation;
+            }
+        };
+        mutable ftxui::Element scrollbar_element_;
+        mutable TrackLayout scrollbar_layout_;
+        mutable ftxui::Element minimap_element_;
+        mutable TrackLayout minimap_layout_;
+        mutable ftxui::Box minimap_box_; // Screen area of the minimap in the last frame, for mouse clicks
+        static constexpr int kMinimapWidth = 4; // One column each for errors, warnings, filter matches and search hits
+
+        // Trigram index over the first GetEntryCount() log entries; entries appended later are scanned directly.
+        // The builder is started, cancelled and drained only on the UI thread (tailed lines are applied in BeginFrame)
+        std::shared_ptr<const TrigramIndex> search_index_;
+        TrigramIndexBuilder search_index_builder_;
+        bool search_index_enabled_ = true;
+        static constexpr size_t kMinIndexedEntries = 50000; // Smaller logs are scanned faster than indexed
+
         // Event handlers
         auto
             OnNewLogLines(
                 const std::vector<std::string>& new_lines)
                 -> void;
+        // File monitor callback: hands tailed lines to the UI thread, which applies them in BeginFrame.
+        // Entries, the filtered view, the search scan and the index builder are only touched by the UI thread
+        auto
+            QueueTailedLines(
+                const std::vector<std::string>& new_lines)
+                -> void;
+        auto
+            ApplyTailedLines()
+                -> void;
+        auto
+            DiscardTailedLines()
+                -> void;
         auto
             OnFiltersChanged()
                 -> void;
@@ -1024,6 +1247,27 @@ namespace ue_log
         auto
             GetVisibleHeight() const
                 -> int;
+        // Width available to one log row (terminal width minus borders and scrollbar)
+        auto
+            GetLogRowWidth() const
+                -> int;
+        // Width and line count of the detail view's text area
+        auto
+            GetDetailViewWidth() const
+                -> int;
+        auto
+            GetDetailViewVisibleHeight() const
+                -> int;
+        // Wrapped raw line of the selected entry at the detail view's width, or nullptr without a selection
+        auto
+            GetDetailViewLayout() const
+                -> const WrapLayout*;
+        // Range of view indices [first, end) that fits on screen, starting near scroll_offset_
+        // and always containing the selection; word-wrapped rows count by their wrapped height
+        auto
+            GetVisibleRowRange(
+                int visible_height) const
+                -> std::pair<int, int>;
         auto
             RenderLogTable() const
                 -> ftxui::Element;
@@ -1037,12 +1281,31 @@ namespace ue_log
             RenderHelpDialog() const
                 -> ftxui::Element;
 
+        // Per-frame state shared by every row of the log table, computed once per frame
+        struct RowRenderContext {
+            std::string highlight_term;       // Search query, or the selected filter's term
+            bool highlight_case_sensitive = false;
+            bool is_filter_highlight = false;
+            bool highlight_is_search = false; // The term is the scanned query, so rows can reuse the search's spans
+            std::pair<int, int> visual_range{-1, -1};
+        };
+
         // Rendering helpers
+        auto
+            BuildRowRenderContext() const
+                -> RowRenderContext;
         auto
             RenderLogEntry(
-                const LogEntry& entry,
-                bool is_selected) const
+                size_t view_index,
+                bool is_selected,
+                const RowRenderContext& context) const
                 -> ftxui::Element;
+        // What the search pass recorded for a row: its spans if it is a result, or that it is not one
+        auto
+            GetRowMatchSpans(
+                size_t view_index,
+                const RowRenderContext& context) const
+                -> RowMatchSpans;
         auto
             RenderTableHeader() const
                 -> ftxui::Element;
@@ -1058,6 +1321,19 @@ namespace ue_log
         auto
             RenderCustomScrollbar() const
                 -> ftxui::Element;
+        auto
+            RenderMinimap() const
+                -> ftxui::Element;
+        auto
+            RenderPerfHud() const
+                -> ftxui::Element;
+        auto
+            ComputeTrackLayout() const
+                -> TrackLayout;
+        auto
+            HandleMinimapClick(
+                const ftxui::Mouse& mouse)
+                -> bool;
         auto
             GetColorForLogLevel(
                 const std::string& level) const
@@ -1103,6 +1379,74 @@ namespace ue_log
             RenderSearchStatusBar() const
                 -> ftxui::Element;
 
+        // Search helpers
+        auto
+            StartSearchScan(
+                const std::string& query)
+                -> void;
+        auto
+            LaunchSearchScan()
+                -> void;
+        auto
+            CollectSearchProgress()
+                -> bool;
+        auto
+            IsSearchScanPending() const
+                -> bool;
+        auto
+            ContinuePendingSearch()
+                -> void;
+        auto
+            ResetSearchScan()
+                -> void;
+        auto
+            RestartSearchScan()
+                -> void;
+        // Whether an entry matches the search query; spans receives the matches in its message
+        auto
+            EntryMatchesSearch(
+                const LogEntry& entry,
+                std::vector<string_search::MatchSpan>& spans) const
+                -> bool;
+        auto
+            CollectIndexedSearchResults(
+                const TrigramIndex& index)
+                -> void;
+
+        // Level navigation helpers
+        auto
+            JumpToLevel(
+                const std::string& level,
+                const std::string& label,
+                bool forward)
+                -> void;
+        auto
+            FindLevelRow(
+                const std::string& level,
+                bool forward,
+                bool& wrapped)
+                -> int;
+        auto
+            UpdateFilteredLevelRows()
+                -> void;
+        auto
+            ResetFilteredLevelRows()
+                -> void;
+        auto
+            UpdateViewHistogram()
+                -> void;
+
+        // Search index helpers
+        auto
+            StartSearchIndexBuild()
+                -> void;
+        auto
+            ResetSearchIndex()
+                -> void;
+        auto
+            AcquireSearchIndex()
+                -> const TrigramIndex*;
+
         // Filter application helpers
         auto
             ApplyCurrentFilter()
@@ -1110,9 +1454,25 @@ namespace ue_log
         auto
             ApplyTraditionalFilters()
                 -> void;
+        auto
+            ShowAllLogEntries()
+                -> void;
         auto
             BuildContextEntries(
-                const std::vector<LogEntry>& matches)
+                const std::vector<size_t>& match_indices)
+                -> void;
+        auto
+            AppendContextRange(
+                size_t begin,
+                size_t end)
                 -> void;
+        auto
+            MarkContextMatch(
+                size_t match_index)
+                -> void;
+        auto
+            IsContextEntry(
+                size_t view_index) const
+                -> bool;
     };
 } // namespace ue_log
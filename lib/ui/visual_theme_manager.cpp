@@ -1,9 +1,9 @@
 #include "visual_theme_manager.h"
+#include "../common/logger_color_key.h"
 
 namespace ue_log {
 
-VisualThemeManager::VisualThemeManager() 
-    : next_color_index_(0) {
+VisualThemeManager::VisualThemeManager() {
     InitializeColorPalette();
     InitializeFontConfiguration();
 }
@@ -63,28 +63,12 @@ void VisualThemeManager::InitializeFontConfiguration() {
     font_sizes_["label"] = 0;              // Labels use normal size
 }
 
-ftxui::Color VisualThemeManager::GetLoggerColor(const std::string& logger_name) {
-    // Check if we already have a color assigned for this logger
-    auto it = logger_color_cache_.find(logger_name);
-    if (it != logger_color_cache_.end()) {
-        return it->second;
-    }
-    
-    // Assign a new color from the cycling palette
-    return AssignLoggerColor(logger_name);
+ftxui::Color VisualThemeManager::GetLoggerColor(const std::string& logger_name) const {
+    return GetLoggerColorByKey(ComputeLoggerColorKey(logger_name));
 }
 
-ftxui::Color VisualThemeManager::AssignLoggerColor(const std::string& logger_name) {
-    // Get the next color from the palette
-    ftxui::Color assigned_color = logger_color_palette_[next_color_index_];
-    
-    // Cache the assignment for consistency
-    logger_color_cache_[logger_name] = assigned_color;
-    
-    // Advance to the next color, cycling back to the beginning if needed
-    next_color_index_ = (next_color_index_ + 1) % logger_color_palette_.size();
-    
-    return assigned_color;
+ftxui::Color VisualThemeManager::GetLoggerColorByKey(uint32_t color_key) const {
+    return logger_color_palette_[color_key % logger_color_palette_.size()];
 }
 
 ftxui::Color VisualThemeManager::GetLogLevelColor(const std::string& log_level) const {
@@ -224,7 +208,7 @@ void VisualThemeManager::SetEyeStrainReductionEnabled(bool enabled) {
         eye_strain_reduction_enabled_ = enabled;
         // Reinitialize color palette with new settings
         InitializeColorPalette();
-        // Clear logger color cache to apply new colors
+        // Restyle logger badges with the new palette
         ResetLoggerColors();
     }
 }
@@ -245,11 +229,11 @@ VisualThemeManager::ColumnSpacing VisualThemeManager::GetColumnSpacing() const {
 
 void VisualThemeManager::SetColumnSpacing(const ColumnSpacing& spacing) {
     column_spacing_ = spacing;
+    ++theme_generation_;
 }
 
 void VisualThemeManager::ResetLoggerColors() {
-    logger_color_cache_.clear();
-    next_color_index_ = 0;
+    ++theme_generation_;
 }
 
 size_t VisualThemeManager::GetAvailableLoggerColorCount() const {
@@ -266,6 +250,7 @@ std::string VisualThemeManager::GetColumnSeparator() const {
 
 void VisualThemeManager::SetVisualSeparatorsEnabled(bool enabled) {
     column_spacing_.use_visual_separators = enabled;
+    ++theme_generation_;
 }
 
 } // namespace ue_log
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <ftxui/screen/color.hpp>
+#include <cstdint>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -41,11 +42,18 @@ public:
     
     /**
      * Get a consistent color for a logger name.
-     * Colors are assigned cyclically and cached for consistency.
+     * The color is picked by a hash of the name, so it does not depend on the order loggers are seen in.
      * @param logger_name The name of the logger
      * @return FTXUI Color for the logger
      */
-    ftxui::Color GetLoggerColor(const std::string& logger_name);
+    ftxui::Color GetLoggerColor(const std::string& logger_name) const;
+    
+    /**
+     * Get the color for a logger color key precomputed by LogCategoryIndex.
+     * @param color_key ComputeLoggerColorKey of the logger name
+     * @return FTXUI Color for the logger
+     */
+    ftxui::Color GetLoggerColorByKey(uint32_t color_key) const;
     
     /**
      * Get color for a log level.
@@ -195,32 +203,36 @@ public:
     
     /**
      * Reset logger color assignments.
-     * Clears the cache and starts color cycling from the beginning.
+     * Colors follow from the logger names, so this only marks styled elements as stale (e.g. after a palette change).
      */
     void ResetLoggerColors();
     
+    /**
+     * Get the theme generation, bumped whenever colors, spacing or separators change.
+     * Lets renderers that cache styled elements tell when they are stale.
+     * @return Current generation number
+     */
+    uint64_t GetThemeGeneration() const { return theme_generation_; }
+    
     /**
      * Get the number of available logger colors.
-     * @return Number of colors in the cycling palette
+     * @return Number of colors in the logger palette
      */
     size_t GetAvailableLoggerColorCount() const;
 
 private:
-    // Color palette for logger badges (cycling through these)
+    // Color palette for logger badges (indexed by logger color key)
     std::vector<ftxui::Color> logger_color_palette_;
     
-    // Cache for consistent logger color assignment
-    std::unordered_map<std::string, ftxui::Color> logger_color_cache_;
-    
-    // Index for cycling through logger colors
-    size_t next_color_index_;
-    
     // Column spacing configuration
     ColumnSpacing column_spacing_;
     
     // Visual polish configuration
     bool eye_strain_reduction_enabled_ = true;
     
+    // Incremented by every setter that changes how elements are styled
+    uint64_t theme_generation_ = 0;
+    
     // Font configuration
     std::unordered_map<std::string, bool> font_weights_;
     std::unordered_map<std::string, int> font_sizes_;
@@ -236,13 +248,6 @@ private:
      * Initialize font configuration with default settings.
      */
     void InitializeFontConfiguration();
-    
-    /**
-     * Assign a new color to a logger from the cycling palette.
-     * @param logger_name The logger name to assign a color to
-     * @return The assigned color
-     */
-    ftxui::Color AssignLoggerColor(const std::string& logger_name);
 };
 
 } // namespace ue_log
\ No newline at end of file